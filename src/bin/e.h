@@ -208,6 +208,7 @@ extern E_API Eina_Bool after_restart;
 
 extern EINTERN const char *e_first_frame;
 extern EINTERN double e_first_frame_start_time;
+EINTERN void e_main_first_frame_done(void);
 
 //#define SMARTERR(args...) abort()
 #define SMARTERRNR() return
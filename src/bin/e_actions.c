@@ -3879,7 +3879,7 @@ e_action_add(const char *name)
 {
    E_Action *act;
 
-   act = e_action_find(name);
+   act = eina_hash_find(actions, name);
    if (!act)
      {
         act = E_OBJECT_ALLOC(E_Action, E_ACTION_TYPE, _e_action_free);
@@ -3888,6 +3888,7 @@ e_action_add(const char *name)
         eina_hash_direct_add(actions, act->name, act);
         action_names = eina_list_append(action_names, name);
         action_list = eina_list_append(action_list, act);
+        e_module_action_register(name);
      }
    return act;
 }
@@ -3907,6 +3908,9 @@ e_action_find(const char *name)
    E_Action *act;
 
    act = eina_hash_find(actions, name);
+   /* the action may belong to a module that is only loaded on demand */
+   if ((!act) && (e_module_action_load(name)))
+     act = eina_hash_find(actions, name);
    return act;
 }
 
@@ -41,6 +41,13 @@ static E_Drag *client_drag = NULL;
 static Eina_List *focus_stack = NULL;
 static Eina_List *raise_stack = NULL;
 
+static Eina_List *changed_clients = NULL; // clients queued for the eval pipeline
+static Eina_List *changed_clients_eval = NULL; // clients being evaluated in pass 3
+static Eina_List *changed_clients_ignored = NULL; // changed clients waiting for unignore
+static unsigned int changed_layers_indexed[E_LAYER_COUNT]; // layer restacks + 1 at last indexing
+static E_Client_Eval_Stats eval_stats = {0};
+static int changed_comp_w = -1, changed_comp_h = -1;
+
 static Eina_Bool comp_grabbed = EINA_FALSE;
 static Evas_Object *action_rect;
 
@@ -560,6 +567,13 @@ _e_client_free(E_Client *ec)
 
    focus_stack = eina_list_remove(focus_stack, ec);
    raise_stack = eina_list_remove(raise_stack, ec);
+   if (ec->on_changed_list)
+     {
+        changed_clients = eina_list_remove(changed_clients, ec);
+        changed_clients_eval = eina_list_remove(changed_clients_eval, ec);
+        ec->on_changed_list = 0;
+     }
+   changed_clients_ignored = eina_list_remove(changed_clients_ignored, ec);
 
    e_hints_client_list_set();
    if (ec->e.state.profile.wait_desk)
@@ -2443,15 +2457,132 @@ _e_client_frame_update(E_Client *ec)
 }
 
 ////////////////////////////////////////////////
+static void
+_e_client_changed_list_add(E_Client *ec)
+{
+   if (ec->on_changed_list) return;
+   ec->on_changed_list = 1;
+   changed_clients = eina_list_append(changed_clients, ec);
+}
+
+static int
+_e_client_changed_list_stack_cmp(const void *data1, const void *data2)
+{
+   const E_Client *ec1 = data1, *ec2 = data2;
+   unsigned int x1, x2;
+
+   /* clients which are not stacked yet go last */
+   if ((!ec1->stack_idx) || (!ec2->stack_idx))
+     return (!ec1->stack_idx) - (!ec2->stack_idx);
+   x1 = e_comp_canvas_layer_map(ec1->layer);
+   x2 = e_comp_canvas_layer_map(ec2->layer);
+   if (x1 != x2) return (x1 < x2) ? -1 : 1;
+   if (ec1->stack_idx == ec2->stack_idx) return 0;
+   return (ec1->stack_idx < ec2->stack_idx) ? -1 : 1;
+}
+
+/* pass 3 evaluates bottom to top like a walk over all clients would. the
+ * queued clients are sorted by their position in their layer, which is only
+ * numbered again once clients were stacked into that layer since */
+static Eina_List *
+_e_client_changed_list_stack_sort(Eina_List *list)
+{
+   const Eina_List *l;
+   Eina_Inlist *il;
+   unsigned int x, n;
+   E_Client *ec, *ec2;
+
+   if (eina_list_count(list) < 2) return list;
+   EINA_LIST_FOREACH(list, l, ec)
+     {
+        x = e_comp_canvas_layer_map(ec->layer);
+        il = EINA_INLIST_GET(ec);
+        if ((x >= E_LAYER_COUNT) ||
+            ((!il->prev) && (!il->next) && (e_comp->layers[x].clients != il)))
+          {
+             ec->stack_idx = 0;
+             continue;
+          }
+        if (changed_layers_indexed[x] == e_comp->layers[x].restacks + 1)
+          continue;
+        n = 1;
+        EINA_INLIST_FOREACH(e_comp->layers[x].clients, ec2)
+          ec2->stack_idx = n++;
+        changed_layers_indexed[x] = e_comp->layers[x].restacks + 1;
+     }
+   return eina_list_sort(list, 0, _e_client_changed_list_stack_cmp);
+}
+
+static void
+_e_client_stack_position_update(E_Client *ec)
+{
+   Eina_List *ll, *list = e_client_stack_list_prepare(ec);
+   E_Client *child, *bottom, *moving = NULL, *rel;
+   int x, y;
+
+   bottom = rel = e_client_stack_bottom_get(ec);
+   EINA_LIST_FOREACH(list, ll, child)
+     {
+        if (child->moving)
+          {
+             moving = child;
+             break;
+          }
+     }
+   if (moving)
+     rel = moving;
+   EINA_LIST_FOREACH(list, ll, child)
+     {
+        if (moving)
+          {
+             if (child == moving) continue;
+          }
+        else if (child == bottom) continue;
+        x = rel->x + ((rel->w - child->w) / 2);
+        y = rel->y + ((rel->h - child->h) / 2);
+        if ((x != child->x)  || (y != child->y))
+          {
+             child->x = x;
+             child->y = y;
+             child->pre_cb.x = x;
+             child->pre_cb.y = y;
+             child->changes.pos = 1;
+             EC_CHANGED(child);
+          }
+     }
+   e_client_stack_list_finish(list);
+}
+
 EINTERN void
 e_client_idler_before(void)
 {
    const Eina_List *l;
+   Eina_List *stacks = NULL, *ll, *lll;
    E_Client *ec;
+   unsigned int count;
+   double trace;
 
-   if ((!eina_hash_population(clients_hash[0])) && (!eina_hash_population(clients_hash[1]))) return;
+   /* a screen size change can leave any client outside the visible area,
+    * so every client needs the lost window check once */
+   if ((changed_comp_w != e_comp->w) || (changed_comp_h != e_comp->h))
+     {
+        changed_comp_w = e_comp->w;
+        changed_comp_h = e_comp->h;
+        EINA_LIST_FOREACH(e_comp->clients, l, ec)
+          _e_client_changed_list_add(ec);
+     }
+   EINA_LIST_FOREACH_SAFE(changed_clients_ignored, ll, lll, ec)
+     {
+        if (ec->ignored) continue;
+        changed_clients_ignored = eina_list_remove_list(changed_clients_ignored, ll);
+        if (ec->changed) _e_client_changed_list_add(ec);
+     }
+   if (!changed_clients) return;
+   trace = e_comp_trace_begin();
 
-   EINA_LIST_FOREACH(e_comp->clients, l, ec)
+   /* clients marked during passes 1 and 2 are appended to the queue and
+    * picked up by the same walk */
+   EINA_LIST_FOREACH(changed_clients, l, ec)
      {
         Eina_Stringshare *title;
         // pass 1 - eval0. fetch properties on new or on change and
@@ -2477,9 +2608,11 @@ e_client_idler_before(void)
         _e_client_hook_call(E_CLIENT_HOOK_EVAL_POST_FRAME_ASSIGN, ec);
      }
 
-   E_CLIENT_FOREACH(ec)
+   EINA_LIST_FOREACH(changed_clients, l, ec)
      {
-        if (ec->ignored) continue;
+        E_Client *bottom;
+
+        if (ec->ignored || e_object_is_del(E_OBJECT(ec))) continue;
         // pass 2 - show windows needing show
         if ((ec->changes.visible) && (ec->visible) &&
             (!ec->new_client) && (!ec->changes.pos) &&
@@ -2502,62 +2635,41 @@ e_client_idler_before(void)
                     _e_client_move_lost_window_to_center(ec);
                }
           }
-        // handle window stack
-        if (!ec->stack.prev && ec->stack.next)
-          {
-             if (ec->stack.ignore == 0)
-               {
-                  Eina_List *ll, *list = e_client_stack_list_prepare(ec);
-                  E_Client *child, *bottom, *moving = NULL, *rel;
-                  int x, y;
-
-                  bottom = rel = e_client_stack_bottom_get(ec);
-                  EINA_LIST_FOREACH(list, ll, child)
-                    {
-                       if (child->moving)
-                         {
-                            moving = child;
-                            break;
-                         }
-                    }
-                  if (moving)
-                    {
-                       Evas_Coord ox, oy;
-
-                       evas_object_geometry_get(ec->frame, &ox, &oy, NULL, NULL);
-                       rel = moving;
-                    }
-                  EINA_LIST_FOREACH(list, ll, child)
-                    {
-                       if (moving)
-                         {
-                            if (child == moving) continue;
-                         }
-                       else if (child == bottom) continue;
-                       x = rel->x + ((rel->w - child->w) / 2);
-                       y = rel->y + ((rel->h - child->h) / 2);
-                       if ((x != child->x)  || (y != child->y))
-                         {
-                            child->x = x;
-                            child->y = y;
-                            child->pre_cb.x = x;
-                            child->pre_cb.y = y;
-                            child->changes.pos = 1;
-                            child->changed = 1;
-                         }
-                    }
-                  e_client_stack_list_finish(list);
-               }
-          }
+        // handle window stack - any change in a stack re-lays out the
+        // whole stack from its bottom client, once per idle
+        if ((!ec->stack.prev) && (!ec->stack.next)) continue;
+        bottom = e_client_stack_bottom_get(ec);
+        if ((!bottom->stack.next) || (bottom->stack.ignore)) continue;
+        if (eina_list_data_find(stacks, bottom)) continue;
+        stacks = eina_list_append(stacks, bottom);
+        _e_client_stack_position_update(bottom);
      }
+   eina_list_free(stacks);
 
    if (_e_client_layout_cb)
      _e_client_layout_cb();
 
    // pass 3 - hide windows needing hide and eval (main eval)
-   E_CLIENT_FOREACH(ec)
+   // clients marked from here on are queued for the next idle
+   changed_clients_eval = _e_client_changed_list_stack_sort(changed_clients);
+   changed_clients = NULL;
+   count = 0;
+   while (changed_clients_eval)
      {
-        if (ec->ignored || e_object_is_del(E_OBJECT(ec))) continue;
+        ec = eina_list_data_get(changed_clients_eval);
+        changed_clients_eval = eina_list_remove_list(changed_clients_eval, changed_clients_eval);
+        ec->on_changed_list = 0;
+        count++;
+
+        if (e_object_is_del(E_OBJECT(ec))) continue;
+        if (ec->ignored)
+          {
+             /* parked off the queue until it is unignored */
+             if ((ec->changed) &&
+                 (!eina_list_data_find(changed_clients_ignored, ec)))
+               changed_clients_ignored = eina_list_append(changed_clients_ignored, ec);
+             continue;
+          }
 
         if ((ec->changes.visible) && (!ec->visible))
           {
@@ -2576,9 +2688,30 @@ e_client_idler_before(void)
              if (!e_client_util_desk_visible(ec, e_desk_current_get(ec->zone)))
                evas_object_hide(ec->frame);
           }
+        if (ec->changed || ec->changes.visible)
+          _e_client_changed_list_add(ec);
      }
+
+   eval_stats.idles++;
+   eval_stats.clients += count;
+   eval_stats.last = count;
+   if (count > eval_stats.max) eval_stats.max = count;
+   e_comp_trace_end(E_COMP_TRACE_CLIENT_EVAL, trace, 0);
 }
 
+E_API void
+e_client_changed_queue(E_Client *ec)
+{
+   ec->changed = 1;
+   _e_client_changed_list_add(ec);
+}
+
+E_API const E_Client_Eval_Stats *
+e_client_eval_stats_get(void)
+{
+   eval_stats.queued = eina_list_count(changed_clients);
+   return &eval_stats;
+}
 
 EINTERN Eina_Bool
 e_client_init(void)
@@ -2624,6 +2757,8 @@ e_client_shutdown(void)
 {
    E_FREE_FUNC(clients_hash[0], eina_hash_free);
    E_FREE_FUNC(clients_hash[1], eina_hash_free);
+   changed_clients = eina_list_free(changed_clients);
+   changed_clients_ignored = eina_list_free(changed_clients_ignored);
 
    E_FREE_LIST(handlers, ecore_event_handler_del);
 
@@ -145,6 +145,7 @@ typedef struct _E_Client_Pending_Resize E_Client_Pending_Resize;
 typedef struct E_Event_Client_Zone_Set E_Event_Client_Zone_Set;
 typedef struct E_Event_Client_Desk_Set E_Event_Client_Desk_Set;
 typedef struct _E_Client_Hook E_Client_Hook;
+typedef struct _E_Client_Eval_Stats E_Client_Eval_Stats;
 
 typedef enum _E_Client_Hook_Point
 {
@@ -252,6 +253,7 @@ struct E_Client
    Eina_List                 *transients;
 
    E_Layer                    layer;
+   unsigned int               stack_idx; // position in its layer when the eval queue was last sorted, 0 if unstacked
 
    Eina_Rectangle           *shape_rects;
    unsigned int              shape_rects_num;
@@ -730,6 +732,16 @@ struct E_Client
    Eina_Bool keyboard_resizing E_BITFIELD;
 
    Eina_Bool on_post_updates E_BITFIELD; // client is on the post update list
+   Eina_Bool on_changed_list E_BITFIELD; // client is queued for the eval pipeline
+};
+
+struct _E_Client_Eval_Stats
+{
+   unsigned long long idles; // idler runs which had clients queued
+   unsigned long long clients; // clients evaluated in total
+   unsigned int last; // clients evaluated by the most recent idler run
+   unsigned int max; // most clients evaluated by a single idler run
+   unsigned int queued; // clients currently waiting for the next idler run
 };
 
 #define e_client_focus_policy_click(ec) \
@@ -741,11 +753,11 @@ struct E_Client
   do { \
      if (e_object_is_del(E_OBJECT(EC))) \
        EINA_LOG_CRIT("CHANGED SET ON DELETED CLIENT!"); \
-     EC->changed = 1; \
+     e_client_changed_queue(EC); \
      INF("%s:%d - EC CHANGED: %p", __FILE__, __LINE__, EC); \
   } while (0)
 #else
-# define EC_CHANGED(EC) EC->changed = 1
+# define EC_CHANGED(EC) e_client_changed_queue(EC)
 #endif
 
 #define E_CLIENT_FOREACH(EC) \
@@ -778,6 +790,8 @@ EINTERN void e_client_idler_before(void);
 EINTERN Eina_Bool e_client_init(void);
 EINTERN void e_client_shutdown(void);
 E_API E_Client *e_client_new(E_Pixmap *cp, int first_map, int internal);
+E_API void e_client_changed_queue(E_Client *ec);
+E_API const E_Client_Eval_Stats *e_client_eval_stats_get(void);
 E_API void e_client_unignore(E_Client *ec);
 E_API void e_client_desk_set(E_Client *ec, E_Desk *desk);
 E_API Eina_Bool e_client_comp_grabbed_get(void);
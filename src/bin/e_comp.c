@@ -369,7 +369,10 @@ static Eina_Bool
 _e_comp_cb_update(void)
 {
    E_Client *ec;
-   Eina_List *l;
+   Eina_Array *updates;
+   unsigned int i, count;
+   unsigned long long damage_pixels, upload_pixels;
+   double trace;
    //   static int doframeinfo = -1;
 
    if (!e_comp) return EINA_FALSE;
@@ -385,15 +388,34 @@ _e_comp_cb_update(void)
 //        e_comp->grabbed = 1;
 //     }
    e_comp->updating = 1;
-   l = e_comp->updates;
-   e_comp->updates = NULL;
-   EINA_LIST_FREE(l, ec)
+   trace = e_comp_trace_begin();
+   /* swap buffers: clients re-queued while updating go to the next frame */
+   updates = e_comp->updates;
+   e_comp->updates = e_comp->updates_flush;
+   e_comp->updates_flush = updates;
+   count = eina_array_count(updates);
+   damage_pixels = e_comp->update_stats.damage_pixels;
+   upload_pixels = e_comp->update_stats.upload_pixels;
+   for (i = 0; i < count; i++)
      {
+        ec = eina_array_data_get(updates, i);
         /* clear update flag */
         e_comp_object_render_update_del(ec->frame);
         _e_comp_client_update(ec);
      }
+   eina_array_clean(updates);
+   if (count)
+     {
+        e_comp->update_stats.frames++;
+        e_comp->update_stats.clients += count;
+        if (count > e_comp->update_stats.max)
+          e_comp->update_stats.max = count;
+     }
+   e_comp->update_stats.last = count;
+   e_comp->update_stats.last_damage_pixels = e_comp->update_stats.damage_pixels - damage_pixels;
+   e_comp->update_stats.last_upload_pixels = e_comp->update_stats.upload_pixels - upload_pixels;
    e_comp->updating = 0;
+   e_comp_trace_end(E_COMP_TRACE_CLIENT_UPDATE, trace, 0);
    _e_comp_fps_update();
    if (conf->fps_show)
      {
@@ -460,7 +482,7 @@ _e_comp_cb_update(void)
         //        if (!e_comp->nocomp) ecore_evas_manual_render(e_comp->ee);
      }
 
-   if (e_comp->updates && (!e_comp->update_job))
+   if (eina_array_count(e_comp->updates) && (!e_comp->update_job))
      ecore_animator_thaw(e_comp->render_animator);
    /*
       if (doframeinfo == -1)
@@ -581,8 +603,59 @@ _e_comp_shapes_update_object_checker_function_thingy(Evas_Object *o)
    return EINA_FALSE;
 }
 
+typedef struct _E_Comp_Shape_Op
+{
+   Eina_Rectangle r;
+   Eina_Bool del;
+} E_Comp_Shape_Op;
+
+typedef struct _E_Comp_Shape_Obj
+{
+   Evas_Object *obj;
+   unsigned int first; // first op of this object
+   unsigned int count; // number of ops of this object
+   Eina_Rectangle bounds; // bounding box of all ops
+   Eina_Bool seen E_BITFIELD; // matched by the next run
+} E_Comp_Shape_Obj;
+
+typedef struct _E_Comp_Shape_Idx
+{
+   Evas_Object *obj;
+   unsigned int idx;
+} E_Comp_Shape_Idx;
+
+/* input shape state from the previous update: each object's tiler ops are
+ * kept so that the next update only recomputes the region touched by
+ * objects which changed, moved in the stack, appeared or went away */
+static struct
+{
+   Eina_Inarray *ops[2]; // E_Comp_Shape_Op: [0] this run, [1] last run
+   Eina_Inarray *objs[2]; // E_Comp_Shape_Obj, bottom to top
+   Eina_Inarray *idx; // E_Comp_Shape_Idx of objs[1], sorted by object
+   Eina_Rectangle *rects[2]; // input shape rects: [0] current, [1] scratch
+   unsigned int rects_num;
+   unsigned int rects_size[2];
+   unsigned int rects_full; // rect count after the last full recompute
+   int w, h; // compositor size of the last run
+   Eina_Bool valid E_BITFIELD; // last run state can be reused
+} shapes;
+
+static void
+_e_comp_shape_op_add(Eina_Inarray *ops, int x, int y, int w, int h, Eina_Bool del)
+{
+   E_Comp_Shape_Op op;
+
+   if ((w < 1) || (h < 1)) return;
+   /* ops are compared with memcmp(), so the padding must be zeroed too */
+   memset(&op, 0, sizeof(op));
+   EINA_RECTANGLE_SET(&op.r, x, y, w, h);
+   op.del = del;
+   eina_inarray_push(ops, &op);
+   SHAPE_INF("%s: %d,%d@%dx%d", del ? "DEL" : "ADD", x, y, w, h);
+}
+
 static void
-_e_comp_shapes_update_comp_client_shape_comp_helper(E_Client *ec, Eina_Tiler *tb, Eina_List **rl)
+_e_comp_shapes_update_comp_client_shape_comp_helper(E_Client *ec, Eina_Inarray *ops, Eina_List **rl)
 {
    int x, y, w, h;
 
@@ -612,25 +685,13 @@ _e_comp_shapes_update_comp_client_shape_comp_helper(E_Client *ec, Eina_Tiler *tb
         if ((l + x) || (r + (w - ec->w + x)) || (t - y) || (b + (h - ec->h + y)))
           {
              if (t - y)
-               {
-                  eina_tiler_rect_add(tb, &(Eina_Rectangle){ec->x + x, ec->y + y, w, t - y});
-                  SHAPE_INF("ADD: %d,%d@%dx%d", ec->x + x, ec->y + y, w, t - y);
-               }
+               _e_comp_shape_op_add(ops, ec->x + x, ec->y + y, w, t - y, EINA_FALSE);
              if (l - x)
-               {
-                  eina_tiler_rect_add(tb, &(Eina_Rectangle){ec->x + x, ec->y + y, l - x, h});
-                  SHAPE_INF("ADD: %d,%d@%dx%d", ec->x + x, ec->y + y, l - x, h);
-               }
+               _e_comp_shape_op_add(ops, ec->x + x, ec->y + y, l - x, h, EINA_FALSE);
              if (r + (w - ec->w + x))
-               {
-                  eina_tiler_rect_add(tb, &(Eina_Rectangle){ec->x + l + ec->client.w + x, ec->y + y, r + (w - ec->w + x), h});
-                  SHAPE_INF("ADD: %d,%d@%dx%d", ec->x + l + ec->client.w + x, ec->y + y, r + (w - ec->w + x), h);
-               }
+               _e_comp_shape_op_add(ops, ec->x + l + ec->client.w + x, ec->y + y, r + (w - ec->w + x), h, EINA_FALSE);
              if (b + (h - ec->h + y))
-               {
-                  eina_tiler_rect_add(tb, &(Eina_Rectangle){ec->x + x, ec->y + t + ec->client.h + y, w, b + (h - ec->h + y)});
-                  SHAPE_INF("ADD: %d,%d@%dx%d", ec->x + x, ec->y + t + ec->client.h + y, w, b + (h - ec->h + y));
-               }
+               _e_comp_shape_op_add(ops, ec->x + x, ec->y + t + ec->client.h + y, w, b + (h - ec->h + y), EINA_FALSE);
           }
         rects = ec->shape_rects ?: ec->shape_input_rects;
         tot = ec->shape_rects_num ?: ec->shape_input_rects_num;
@@ -645,8 +706,7 @@ _e_comp_shapes_update_comp_client_shape_comp_helper(E_Client *ec, Eina_Tiler *tb
              //EINA_RECTANGLE_SET(r, x, y, w, h);
              //rl = eina_list_append(rl, r);
    //#endif
-             eina_tiler_rect_del(tb, &(Eina_Rectangle){x, y, w, h});
-             SHAPE_INF("DEL: %d,%d@%dx%d", x, y, w, h);
+             _e_comp_shape_op_add(ops, x, y, w, h, EINA_TRUE);
           }
         return;
      }
@@ -664,20 +724,18 @@ _e_comp_shapes_update_comp_client_shape_comp_helper(E_Client *ec, Eina_Tiler *tb
      {
         e_comp_object_frame_extends_get(ec->frame, &x, &y, &w, &h);
         /* add the frame */
-        eina_tiler_rect_add(tb, &(Eina_Rectangle){ec->x + x, ec->y + y, w, h});
-        SHAPE_INF("ADD: %d,%d@%dx%d", ec->x + x, ec->y + y, w, h);
+        _e_comp_shape_op_add(ops, ec->x + x, ec->y + y, w, h, EINA_FALSE);
      }
 
    if ((!ec->shaded) && (!ec->shading))
      {
         /* delete the client if not shaded */
-        eina_tiler_rect_del(tb, &(Eina_Rectangle){ec->client.x, ec->client.y, ec->client.w, ec->client.h});
-        SHAPE_INF("DEL: %d,%d@%dx%d", ec->client.x, ec->client.y, ec->client.w, ec->client.h);
+        _e_comp_shape_op_add(ops, ec->client.x, ec->client.y, ec->client.w, ec->client.h, EINA_TRUE);
      }
 }
 
 static void
-_e_comp_shapes_update_object_shape_comp_helper(Evas_Object *o, Eina_Tiler *tb)
+_e_comp_shapes_update_object_shape_comp_helper(Evas_Object *o, Eina_Inarray *ops)
 {
    int x, y, w, h;
 
@@ -694,78 +752,290 @@ _e_comp_shapes_update_object_shape_comp_helper(Evas_Object *o, Eina_Tiler *tb)
         if (content)
           evas_object_geometry_get(content, &x, &y, &w, &h);
      }
-   eina_tiler_rect_add(tb, &(Eina_Rectangle){x, y, w, h});
-   SHAPE_INF("ADD: %d,%d@%dx%d", x, y, w, h);
+   _e_comp_shape_op_add(ops, x, y, w, h, EINA_FALSE);
+}
+
+static int
+_e_comp_shapes_idx_sort_cb(const void *a, const void *b)
+{
+   const E_Comp_Shape_Idx *i1 = a, *i2 = b;
+
+   if (i1->obj == i2->obj) return 0;
+   return (i1->obj < i2->obj) ? -1 : 1;
+}
+
+static Eina_Bool
+_e_comp_shapes_rects_reserve(unsigned int buf, unsigned int num)
+{
+   Eina_Rectangle *tmp;
+   unsigned int size;
+
+   if (num <= shapes.rects_size[buf]) return EINA_TRUE;
+   size = MAX(128, shapes.rects_size[buf]);
+   while (size < num) size *= 2;
+   tmp = realloc(shapes.rects[buf], size * sizeof(Eina_Rectangle));
+   if (!tmp) return EINA_FALSE;
+   shapes.rects[buf] = tmp;
+   shapes.rects_size[buf] = size;
+   return EINA_TRUE;
+}
+
+/* build the input shape inside area from the ops of every object touching
+ * it; rects are written after the first num rects of the current buffer */
+static Eina_Bool
+_e_comp_shapes_region_calc(const Eina_Rectangle *area, unsigned int num)
+{
+   Eina_Tiler *tb;
+   Eina_Iterator *ti;
+   Eina_Rectangle *tr;
+   E_Comp_Shape_Obj *so;
+   E_Comp_Shape_Op *op;
+   Eina_Bool ret = EINA_TRUE;
+   unsigned int i;
+
+   tb = eina_tiler_new(area->w, area->h);
+   if (!tb) return EINA_FALSE;
+   eina_tiler_tile_size_set(tb, 1, 1);
+   /* background */
+   eina_tiler_rect_add(tb, &(Eina_Rectangle){0, 0, area->w, area->h});
+   EINA_INARRAY_FOREACH(shapes.objs[0], so)
+     {
+        if (!eina_rectangles_intersect(&so->bounds, area)) continue;
+        for (i = 0; i < so->count; i++)
+          {
+             Eina_Rectangle r;
+
+             op = eina_inarray_nth(shapes.ops[0], so->first + i);
+             r = op->r;
+             if (!eina_rectangle_intersection(&r, area)) continue;
+             r.x -= area->x, r.y -= area->y;
+             if (op->del)
+               eina_tiler_rect_del(tb, &r);
+             else
+               eina_tiler_rect_add(tb, &r);
+          }
+     }
+   ti = eina_tiler_iterator_new(tb);
+   EINA_ITERATOR_FOREACH(ti, tr)
+     {
+        if (!_e_comp_shapes_rects_reserve(0, num + 1))
+          {
+             ret = EINA_FALSE;
+             break;
+          }
+        EINA_RECTANGLE_SET(&shapes.rects[0][num], tr->x + area->x, tr->y + area->y, tr->w, tr->h);
+        num++;
+     }
+   eina_iterator_free(ti);
+   eina_tiler_free(tb);
+   shapes.rects_num = num;
+   return ret;
+}
+
+/* drop dirty from the current rects, splitting rects which overlap it */
+static Eina_Bool
+_e_comp_shapes_region_cut(const Eina_Rectangle *dirty)
+{
+   Eina_Rectangle *tmp;
+   unsigned int i, num = 0, size;
+
+   if (!_e_comp_shapes_rects_reserve(1, (shapes.rects_num * 4) + 1)) return EINA_FALSE;
+   for (i = 0; i < shapes.rects_num; i++)
+     {
+        Eina_Rectangle *r = &shapes.rects[0][i], *out = shapes.rects[1];
+        int x1, y1, x2, y2;
+
+        if (!eina_rectangles_intersect(r, dirty))
+          {
+             out[num++] = *r;
+             continue;
+          }
+        x1 = MAX(r->x, dirty->x), x2 = MIN(r->x + r->w, dirty->x + dirty->w);
+        y1 = MAX(r->y, dirty->y), y2 = MIN(r->y + r->h, dirty->y + dirty->h);
+        if (r->y < y1)
+          EINA_RECTANGLE_SET(&out[num++], r->x, r->y, r->w, y1 - r->y);
+        if (r->y + r->h > y2)
+          EINA_RECTANGLE_SET(&out[num++], r->x, y2, r->w, r->y + r->h - y2);
+        if (r->x < x1)
+          EINA_RECTANGLE_SET(&out[num++], r->x, y1, x1 - r->x, y2 - y1);
+        if (r->x + r->w > x2)
+          EINA_RECTANGLE_SET(&out[num++], x2, y1, r->x + r->w - x2, y2 - y1);
+     }
+   tmp = shapes.rects[0], shapes.rects[0] = shapes.rects[1], shapes.rects[1] = tmp;
+   size = shapes.rects_size[0], shapes.rects_size[0] = shapes.rects_size[1], shapes.rects_size[1] = size;
+   shapes.rects_num = num;
+   return EINA_TRUE;
+}
+
+/* find the region affected by changes since the last run; returns false if
+ * nothing changed */
+static Eina_Bool
+_e_comp_shapes_dirty_get(Eina_Rectangle *dirty)
+{
+   E_Comp_Shape_Obj *so, *pso;
+   E_Comp_Shape_Idx *si, key;
+   Eina_Bool found = EINA_FALSE;
+   int maxold = -1;
+   unsigned int n = 0;
+
+#define DIRTY_ADD(R) \
+   do { \
+        if (found) eina_rectangle_union(dirty, (R)); \
+        else *dirty = *(R), found = EINA_TRUE; \
+   } while (0)
+
+   eina_inarray_flush(shapes.idx);
+   EINA_INARRAY_FOREACH(shapes.objs[1], pso)
+     {
+        E_Comp_Shape_Idx i = { pso->obj, n++ };
+
+        pso->seen = 0;
+        eina_inarray_push(shapes.idx, &i);
+     }
+   eina_inarray_sort(shapes.idx, _e_comp_shapes_idx_sort_cb);
+   EINA_INARRAY_FOREACH(shapes.objs[0], so)
+     {
+        int pos;
+
+        key.obj = so->obj;
+        pos = eina_inarray_search_sorted(shapes.idx, &key, _e_comp_shapes_idx_sort_cb);
+        if (pos < 0)
+          {
+             DIRTY_ADD(&so->bounds);
+             continue;
+          }
+        si = eina_inarray_nth(shapes.idx, pos);
+        pso = eina_inarray_nth(shapes.objs[1], si->idx);
+        pso->seen = 1;
+        if ((pso->count != so->count) ||
+            memcmp(eina_inarray_nth(shapes.ops[1], pso->first),
+                   eina_inarray_nth(shapes.ops[0], so->first),
+                   so->count * sizeof(E_Comp_Shape_Op)))
+          {
+             DIRTY_ADD(&pso->bounds);
+             DIRTY_ADD(&so->bounds);
+          }
+        /* an object now stacked above something which used to be above it
+         * can only change the shape where the two overlap */
+        else if ((int)si->idx < maxold)
+          DIRTY_ADD(&so->bounds);
+        maxold = MAX(maxold, (int)si->idx);
+     }
+   EINA_INARRAY_FOREACH(shapes.objs[1], pso)
+     if (!pso->seen) DIRTY_ADD(&pso->bounds);
+#undef DIRTY_ADD
+   return found;
 }
 
 static void
 _e_comp_shapes_update_job(void *d EINA_UNUSED)
 {
-   Eina_Tiler *tb;
    E_Client *ec;
    Evas_Object *o = NULL;
-   Eina_Rectangle *tr;
-   Eina_Iterator *ti;
-   Eina_Rectangle *exr;
-   unsigned int i, tile_count;
+   Eina_Inarray *tmp;
+   Eina_Rectangle dirty = {0, 0, 0, 0};
+   unsigned int i;
    Ecore_Window win;
    Eina_Rectangle *r;
    Eina_List *rl = NULL;
    E_Color color = {0};
    const char *type;
+   Eina_Bool full, ok;
+   double trace = e_comp_trace_begin();
 
    SHAPE_INF("---------------------");
 
+   if (!shapes.ops[0])
+     {
+        for (i = 0; i < 2; i++)
+          {
+             shapes.ops[i] = eina_inarray_new(sizeof(E_Comp_Shape_Op), 64);
+             shapes.objs[i] = eina_inarray_new(sizeof(E_Comp_Shape_Obj), 32);
+          }
+        shapes.idx = eina_inarray_new(sizeof(E_Comp_Shape_Idx), 32);
+     }
    if (e_comp->comp_type == E_PIXMAP_TYPE_X)
      win = e_comp->win;
    else
      win = e_comp->cm_selection;
    E_FREE_LIST(e_comp->debug_rects, evas_object_del);
-   tb = eina_tiler_new(e_comp->w, e_comp->h);
-   eina_tiler_tile_size_set(tb, 1, 1);
-   /* background */
-   eina_tiler_rect_add(tb, &(Eina_Rectangle){0, 0, e_comp->w, e_comp->h});
 
+   eina_inarray_flush(shapes.ops[0]);
+   eina_inarray_flush(shapes.objs[0]);
    ec = e_client_bottom_get();
    if (ec) o = ec->frame;
    for (; o; o = evas_object_above_get(o))
      {
+        E_Comp_Shape_Obj so = { o, eina_inarray_count(shapes.ops[0]), 0, {0, 0, 0, 0}, 0 };
         int layer;
 
         layer = evas_object_layer_get(o);
         if (e_comp_canvas_client_layer_map(layer) == 9999) //not a client layer
+          _e_comp_shapes_update_object_shape_comp_helper(o, shapes.ops[0]);
+        else
           {
-             _e_comp_shapes_update_object_shape_comp_helper(o, tb);
-             continue;
+             ec = NULL;
+             type = evas_object_type_get(o);
+             if ((type) && (!strcmp(type, "e_comp_object")))
+               ec = e_comp_object_client_get(o);
+             if (ec && (!ec->no_shape_cut))
+               _e_comp_shapes_update_comp_client_shape_comp_helper(ec, shapes.ops[0]
+                                                                   ,&rl
+                                                                  );
+
+             else
+               _e_comp_shapes_update_object_shape_comp_helper(o, shapes.ops[0]);
           }
-        ec = NULL;
-        type = evas_object_type_get(o);
-        if ((type) && (!strcmp(type, "e_comp_object")))
-          ec = e_comp_object_client_get(o);
-        if (ec && (!ec->no_shape_cut))
-          _e_comp_shapes_update_comp_client_shape_comp_helper(ec, tb
-                                                              ,&rl
-                                                             );
+        so.count = eina_inarray_count(shapes.ops[0]) - so.first;
+        if (!so.count) continue;
+        for (i = 0; i < so.count; i++)
+          {
+             E_Comp_Shape_Op *op = eina_inarray_nth(shapes.ops[0], so.first + i);
 
-        else
-          _e_comp_shapes_update_object_shape_comp_helper(o, tb);
+             if (i) eina_rectangle_union(&so.bounds, &op->r);
+             else so.bounds = op->r;
+          }
+        eina_inarray_push(shapes.objs[0], &so);
      }
 
-   ti = eina_tiler_iterator_new(tb);
-   tile_count = 128;
-   exr = malloc(sizeof(Eina_Rectangle) * tile_count);
-   i = 0;
-   EINA_ITERATOR_FOREACH(ti, tr)
+   full = shape_debug || (!shapes.valid) ||
+     (shapes.w != e_comp->w) || (shapes.h != e_comp->h) ||
+     (shapes.rects_num > (shapes.rects_full * 2) + 64);
+   if (!full)
      {
-        exr[i++] = *((Eina_Rectangle *)tr);
-        if (i == tile_count - 1)
-          exr = realloc(exr, sizeof(Eina_Rectangle) * (tile_count *= 2));
-        if (shape_debug)
+        if (!_e_comp_shapes_dirty_get(&dirty))
+          {
+             SHAPE_INF("NO SHAPE CHANGE");
+             goto done;
+          }
+        E_RECTS_CLIP_TO_RECT(dirty.x, dirty.y, dirty.w, dirty.h, 0, 0, e_comp->w, e_comp->h);
+        if ((dirty.w < 1) || (dirty.h < 1)) goto done;
+        /* large changes are cheaper to redo from scratch than to splice */
+        full = ((long long)dirty.w * dirty.h * 2 > (long long)e_comp->w * e_comp->h);
+     }
+   if (full)
+     {
+        ok = _e_comp_shapes_region_calc(&(Eina_Rectangle){0, 0, e_comp->w, e_comp->h}, 0);
+        shapes.rects_full = shapes.rects_num;
+     }
+   else
+     {
+        SHAPE_INF("DIRTY: %d,%d@%dx%d", dirty.x, dirty.y, dirty.w, dirty.h);
+        ok = _e_comp_shapes_region_cut(&dirty) &&
+          _e_comp_shapes_region_calc(&dirty, shapes.rects_num);
+     }
+   shapes.valid = ok;
+   shapes.w = e_comp->w, shapes.h = e_comp->h;
+
+   if (shape_debug)
+     {
+        for (i = 0; i < shapes.rects_num; i++)
           {
              Eina_List *l;
+             Eina_Rectangle *tr = &shapes.rects[0][i];
 
-             _e_comp_shape_debug_rect(&exr[i - 1], &color);
-             SHAPE_INF("%d,%d @ %dx%d", exr[i - 1].x, exr[i - 1].y, exr[i - 1].w, exr[i - 1].h);
+             _e_comp_shape_debug_rect(tr, &color);
+             SHAPE_INF("%d,%d @ %dx%d", tr->x, tr->y, tr->w, tr->h);
              EINA_LIST_FOREACH(rl, l, r)
                {
                   if (E_INTERSECTS(r->x, r->y, r->w, r->h, tr->x, tr->y, tr->w, tr->h))
@@ -775,18 +1045,36 @@ _e_comp_shapes_update_job(void *d EINA_UNUSED)
      }
 
 #ifndef HAVE_WAYLAND_ONLY
-   ecore_x_window_shape_input_rectangles_set(win, (Ecore_X_Rectangle*)exr, i);
+   ecore_x_window_shape_input_rectangles_set(win, (Ecore_X_Rectangle*)shapes.rects[0], shapes.rects_num);
 #endif
 
+done:
    if (shape_debug)
      {
         E_FREE_LIST(rl, free);
         printf("\n");
      }
-   free(exr);
-   eina_iterator_free(ti);
-   eina_tiler_free(tb);
+   tmp = shapes.ops[0], shapes.ops[0] = shapes.ops[1], shapes.ops[1] = tmp;
+   tmp = shapes.objs[0], shapes.objs[0] = shapes.objs[1], shapes.objs[1] = tmp;
    e_comp->shape_job = NULL;
+   e_comp_trace_end(E_COMP_TRACE_SHAPES, trace, 0);
+}
+
+static void
+_e_comp_shapes_free(void)
+{
+   unsigned int i;
+
+   for (i = 0; i < 2; i++)
+     {
+        E_FREE_FUNC(shapes.ops[i], eina_inarray_free);
+        E_FREE_FUNC(shapes.objs[i], eina_inarray_free);
+        E_FREE(shapes.rects[i]);
+        shapes.rects_size[i] = 0;
+     }
+   E_FREE_FUNC(shapes.idx, eina_inarray_free);
+   shapes.rects_num = shapes.rects_full = 0;
+   shapes.valid = 0;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -851,6 +1139,8 @@ _e_comp_free(E_Comp *c)
    if (c->nocomp_delay_timer) ecore_timer_del(c->nocomp_delay_timer);
    if (c->nocomp_override_timer) ecore_timer_del(c->nocomp_override_timer);
    ecore_job_del(c->shape_job);
+   eina_array_free(c->updates);
+   eina_array_free(c->updates_flush);
    free(c->canvas);
    free(c);
 }
@@ -1020,6 +1310,7 @@ e_comp_init(void)
 
    ecore_frametime = ecore_animator_frametime_get();
    shape_debug = !!getenv("E_SHAPE_DEBUG");
+   e_comp_trace_init();
 
    E_EVENT_COMPOSITOR_UPDATE = ecore_event_type_new();
    E_EVENT_COMP_OBJECT_ADD = ecore_event_type_new();
@@ -1406,6 +1697,8 @@ e_comp_new(void)
    e_comp = E_OBJECT_ALLOC(E_Comp, E_COMP_TYPE, _e_comp_free);
    if (!e_comp) return NULL;
    e_comp->canvas = E_NEW(E_Comp_Canvas, 1);
+   e_comp->updates = eina_array_new(16);
+   e_comp->updates_flush = eina_array_new(16);
 
    e_comp->render_animator = ecore_animator_add(_e_comp_cb_animator, NULL);
    ecore_animator_freeze(e_comp->render_animator);
@@ -1446,6 +1739,8 @@ e_comp_shutdown(void)
    conf_edd = NULL;
 
    E_FREE_FUNC(ignores, eina_hash_free);
+   _e_comp_shapes_free();
+   e_comp_trace_shutdown();
 
    return 1;
 }
@@ -120,6 +120,7 @@ struct _E_Comp
       //Eina_Inlist *objs; /* E_Comp_Object; NOT to be exposed; seems pointless? */
       Eina_Inlist *clients; /* E_Client, bottom to top */
       unsigned int clients_count; //count of clients on layer
+      unsigned int restacks; //bumped whenever clients are added to the layer
    } layers[E_LAYER_COUNT];
 
    struct //autoclose handler for e_comp_object_util_autoclose
@@ -137,7 +138,8 @@ struct _E_Comp
    Eina_List *debug_rects; //used when SHAPE_DEBUG is defined in e_comp.c
    Eina_List *ignore_wins; //windows to be ignored by the compositor
 
-   Eina_List      *updates; //E_Clients with render updates
+   Eina_Array     *updates; //E_Clients with render updates
+   Eina_Array     *updates_flush; //E_Clients being updated by the current frame
    Eina_List      *post_updates; //E_Clients awaiting post render flushing
    Ecore_Animator *render_animator; //animator for fixed time rendering
    Ecore_Job      *shape_job; //job to update x11 input shapes
@@ -147,6 +149,17 @@ struct _E_Comp
    int             animating; //number of animating comp objects
    double          frametimes[122]; //used for calculating fps
    int             frameskip;
+   struct
+   {
+      unsigned long long frames; //frames which updated clients
+      unsigned long long clients; //client updates across all frames
+      unsigned int last; //clients updated by the last frame
+      unsigned int max; //most clients updated by a single frame
+      unsigned long long damage_pixels; //pixels damaged by clients, counting overlap
+      unsigned long long upload_pixels; //pixels marked for upload after damage coalescing
+      unsigned long long last_damage_pixels; //pixels damaged for the last frame
+      unsigned long long last_upload_pixels; //pixels marked for upload by the last frame
+   } update_stats;
 
    int             nocomp_override; //number of times nocomp override has been requested
    Ecore_Window block_win;
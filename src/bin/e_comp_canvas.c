@@ -4,6 +4,7 @@ static Eina_List *handlers;
 static Ecore_Timer *timer_post_screensaver_lock = NULL;
 static Ecore_Timer *timer_post_screensaver_on = NULL;
 static Ecore_Timer *timer_pointer_freeze = NULL;
+static double render_trace = 0.0;
 
 static void
 _e_comp_canvas_cb_del()
@@ -27,13 +28,17 @@ _e_comp_canvas_cb_first_frame(void *data EINA_UNUSED, Evas *e, void *event_info
 {
    double now = ecore_time_get();
 
-   switch (e_first_frame[0])
+   e_main_first_frame_done();
+   if (e_first_frame)
      {
-      case 'A': abort();
-      case 'E':
-      case 'D': exit(-1);
-      case 'T': fprintf(stderr, "Startup time: '%f' - '%f' = '%f'\n", now, e_first_frame_start_time, now - e_first_frame_start_time);
-         break;
+        switch (e_first_frame[0])
+          {
+           case 'A': abort();
+           case 'E':
+           case 'D': exit(-1);
+           case 'T': fprintf(stderr, "Startup time: '%f' - '%f' = '%f'\n", now, e_first_frame_start_time, now - e_first_frame_start_time);
+              break;
+          }
      }
 
    evas_event_callback_del_full(e, EVAS_CALLBACK_RENDER_POST, _e_comp_canvas_cb_first_frame, NULL);
@@ -55,6 +60,8 @@ _e_comp_canvas_render_post(void *data EINA_UNUSED, Evas *e EINA_UNUSED, void *ev
      //}
 
    e_comp->rendering = EINA_FALSE;
+   e_comp_trace_end(E_COMP_TRACE_EVAS_RENDER, render_trace, 0);
+   render_trace = 0.0;
 
    EINA_LIST_FREE(e_comp->post_updates, ec)
      {
@@ -363,6 +370,7 @@ _e_comp_canvas_prerender(void *data EINA_UNUSED, Evas *e EINA_UNUSED, void *even
    E_Comp_Config *conf = e_comp_config_get();
 
    e_comp->rendering = EINA_TRUE;
+   render_trace = e_comp_trace_begin();
 
    if (conf->grab && (!e_comp->grabbed))
      {
@@ -397,8 +405,7 @@ e_comp_canvas_init(int w, int h)
 
    e_comp->evas = ecore_evas_get(e_comp->ee);
 
-   if (e_first_frame)
-     evas_event_callback_add(e_comp->evas, EVAS_CALLBACK_RENDER_POST, _e_comp_canvas_cb_first_frame, NULL);
+   evas_event_callback_add(e_comp->evas, EVAS_CALLBACK_RENDER_POST, _e_comp_canvas_cb_first_frame, NULL);
    o = evas_object_rectangle_add(e_comp->evas);
    e_comp->canvas->resize_object = o;
    evas_object_layer_set(o, E_LAYER_BOTTOM);
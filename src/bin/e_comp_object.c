@@ -17,9 +17,13 @@
    - comp_object_skip: object has a name which prohibits theme shadows
    - comp_object-to_del: list of objects which will be deleted when this object is deleted
    - comp_mirror: object is the result of e_comp_object_util_mirror_add()
+
+   = keys that return other data =
+   - comp_mirror_throttle: update limits for a mirror (E_Comp_Object_Mirror_Throttle*)
 */
 
 #define UPDATE_MAX 512 // same as evas
+#define DAMAGE_RECT_COST 1024 // minimum pixels one extra update rect is worth
 #define FAILURE_MAX 2 // seems reasonable
 #define SMART_NAME     "e_comp_object"
 
@@ -88,6 +92,7 @@ typedef struct _E_Comp_Object
    Evas_Object         *frame_volume; // volume level object
    unsigned int         layer; //e_comp_canvas_layer_map(cw->ec->layer)
    Eina_List           *obj_mirror;  // extra mirror objects
+   Ecore_Timer         *mirror_timer; // refreshes throttled mirrors
    Eina_List           *obj_agent;  // extra agent objects
    Eina_Tiler          *updates; //render update regions
    Eina_Tiler          *pending_updates; //render update regions which are about to render
@@ -97,6 +102,10 @@ typedef struct _E_Comp_Object
    double               action_client_loop_time; //loop time when client's action ended
 
    unsigned int         update_count;  // how many updates have happened to this obj
+   Eina_Rectangle       damage_box; // bounding box of damage since last dirty
+   unsigned long long   damage_pixels; // damaged pixels since last dirty, counting overlap
+   double               damage_time; // time of first damage not yet presented, when tracing
+   unsigned int         update_idx;  // index in e_comp->updates while queued for render
 
    unsigned int         opacity;  // opacity set with _NET_WM_WINDOW_OPACITY
 
@@ -133,6 +142,13 @@ typedef struct _E_Comp_Object
    Eina_Bool            agent_updating E_BITFIELD; //updating agents
 } E_Comp_Object;
 
+typedef struct E_Comp_Object_Mirror_Throttle
+{
+   double               interval; // minimum time between mirror updates
+   double               last; // loop time of the last mirror update
+   Eina_Bool            stale E_BITFIELD; // has damage which is not yet shown
+} E_Comp_Object_Mirror_Throttle;
+
 
 struct E_Comp_Object_Mover
 {
@@ -145,6 +161,8 @@ struct E_Comp_Object_Mover
 
 static Eina_Inlist *_e_comp_object_movers = NULL;
 static Evas_Smart *_e_comp_smart = NULL;
+static Eina_Rectangle *render_rects = NULL; // reusable damage rect buffer for e_comp_object_render()
+static unsigned int render_rects_size = 0;
 
 /* sekrit functionzzz */
 EINTERN void e_client_focused_set(E_Client *ec);
@@ -220,22 +238,95 @@ _e_comp_object_cb_agent_move(void *data, Evas *e EINA_UNUSED, Evas_Object *obj,
 
 /////////////////////////////////////
 
+static void _e_comp_object_mirror_throttle_queue(E_Comp_Object *cw);
+
+/* flush accumulated damage to a throttled mirror as a single full update */
+static void
+_e_comp_object_mirror_refresh(E_Comp_Object *cw, Evas_Object *o, E_Comp_Object_Mirror_Throttle *mt)
+{
+   int w, h;
+
+   mt->stale = 0;
+   mt->last = ecore_loop_time_get();
+   if ((!cw->ec) || (!e_pixmap_size_get(cw->ec->pixmap, &w, &h))) return;
+   evas_object_image_pixels_dirty_set(o, 1);
+   evas_object_image_data_update_add(o, 0, 0, w, h);
+}
+
+static Eina_Bool
+_e_comp_object_mirror_throttle_cb(void *data)
+{
+   E_Comp_Object *cw = data;
+   E_Comp_Object_Mirror_Throttle *mt;
+   Eina_List *l;
+   Evas_Object *o;
+   Eina_Bool refresh = EINA_FALSE;
+   double now;
+
+   cw->mirror_timer = NULL;
+   now = ecore_loop_time_get();
+   EINA_LIST_FOREACH(cw->obj_mirror, l, o)
+     {
+        mt = evas_object_data_get(o, "comp_mirror_throttle");
+        if ((!mt) || (!mt->stale) || (!evas_object_visible_get(o))) continue;
+        if (now - mt->last < mt->interval) continue;
+        _e_comp_object_mirror_refresh(cw, o, mt);
+        refresh = EINA_TRUE;
+     }
+   _e_comp_object_mirror_throttle_queue(cw);
+   /* same as e_comp_object_dirty(): pixels must be fetched for the mirrors */
+   if (refresh && (!cw->real_hid) && (!cw->visible) && cw->pending_updates && (!cw->native))
+     e_comp_object_render(cw->smart_obj);
+   return ECORE_CALLBACK_CANCEL;
+}
+
+/* schedule the next refresh for the earliest visible stale mirror;
+ * hidden mirrors stay stale until they are shown again
+ */
+static void
+_e_comp_object_mirror_throttle_queue(E_Comp_Object *cw)
+{
+   E_Comp_Object_Mirror_Throttle *mt;
+   Eina_List *l;
+   Evas_Object *o;
+   Eina_Bool found = EINA_FALSE;
+   double now, next = 0.0, t;
+
+   if (cw->mirror_timer || cw->deleted) return;
+   now = ecore_loop_time_get();
+   EINA_LIST_FOREACH(cw->obj_mirror, l, o)
+     {
+        mt = evas_object_data_get(o, "comp_mirror_throttle");
+        if ((!mt) || (!mt->stale) || (!evas_object_visible_get(o))) continue;
+        t = mt->last + mt->interval - now;
+        if ((!found) || (t < next)) next = t;
+        found = EINA_TRUE;
+     }
+   if (!found) return;
+   cw->mirror_timer = ecore_timer_loop_add(MAX(next, 0.0), _e_comp_object_mirror_throttle_cb, cw);
+}
+
 static void
 _e_comp_object_cb_mirror_del(void *data, Evas *e EINA_UNUSED, Evas_Object *obj, void *event_info EINA_UNUSED)
 {
    E_Comp_Object *cw = data;
 
    cw->obj_mirror = eina_list_remove(cw->obj_mirror, obj);
+   free(evas_object_data_del(obj, "comp_mirror_throttle"));
 }
 
 static void
-_e_comp_object_cb_mirror_show(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
+_e_comp_object_cb_mirror_show(void *data, Evas *e EINA_UNUSED, Evas_Object *obj, void *event_info EINA_UNUSED)
 {
    E_Comp_Object *cw = data;
+   E_Comp_Object_Mirror_Throttle *mt;
 
    if ((!cw->force_visible) && (!cw->deleted) && (!e_object_is_del(E_OBJECT(cw->ec))))
      evas_object_smart_callback_call(cw->smart_obj, "visibility_force", cw->ec);
    cw->force_visible++;
+   mt = evas_object_data_get(obj, "comp_mirror_throttle");
+   if (mt && mt->stale)
+     _e_comp_object_mirror_throttle_queue(cw);
    if ((!cw->native) && cw->pending_updates && (!cw->update) && cw->real_hid)
      e_comp_object_render(cw->smart_obj);
 }
@@ -313,6 +404,7 @@ _e_comp_object_layers_add(E_Comp_Object *cw, E_Comp_Object *above, E_Comp_Object
           e_comp->layers[cw->layer].clients = eina_inlist_append(e_comp->layers[cw->layer].clients, EINA_INLIST_GET(cw->ec));
         e_comp->layers[cw->layer].clients_count++;
      }
+   e_comp->layers[cw->layer].restacks++;
 #ifndef E_RELEASE_BUILD
    if (layer_cw)
      {
@@ -2075,6 +2167,16 @@ _e_comp_smart_cb_shaded(void *data, Evas_Object *obj EINA_UNUSED, void *event_in
    _e_comp_object_shade_animator(cw);
 }
 
+static void
+_e_comp_smart_cb_post_render(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
+{
+   E_Comp_Object *cw = data;
+
+   if (cw->damage_time <= 0.0) return;
+   e_comp_trace_end(E_COMP_TRACE_PRESENT, cw->damage_time, e_pixmap_window_get(cw->ec->pixmap));
+   cw->damage_time = 0.0;
+}
+
 static void
 _e_comp_smart_cb_shading(void *data, Evas_Object *obj, void *event_info)
 {
@@ -2275,6 +2377,7 @@ _e_comp_smart_add(Evas_Object *obj)
    evas_object_intercept_hide_callback_add(obj, _e_comp_intercept_hide, cw);
    evas_object_intercept_focus_set_callback_add(obj, _e_comp_intercept_focus, cw);
 
+   evas_object_smart_callback_add(obj, "post_render", _e_comp_smart_cb_post_render, cw);
    evas_object_smart_callback_add(obj, "shading", _e_comp_smart_cb_shading, cw);
    evas_object_smart_callback_add(obj, "shaded", _e_comp_smart_cb_shaded, cw);
    evas_object_smart_callback_add(obj, "unshading", _e_comp_smart_cb_unshading, cw);
@@ -2437,8 +2540,10 @@ _e_comp_smart_del(Evas_Object *obj)
    E_FREE_FUNC(cw->pending_updates, eina_tiler_free);
    free(cw->ns);
 
+   E_FREE_FUNC(cw->mirror_timer, ecore_timer_del);
    EINA_LIST_FREE(cw->obj_mirror, o)
      {
+        free(evas_object_data_del(o, "comp_mirror_throttle"));
         evas_object_image_data_set(o, NULL);
         evas_object_freeze_events_set(o, 1);
         evas_object_event_callback_del_full(o, EVAS_CALLBACK_DEL, _e_comp_object_cb_mirror_del, cw);
@@ -3709,6 +3814,40 @@ e_comp_object_signal_callback_del_full(Evas_Object *obj, const char *sig, const
    edje_object_signal_callback_del_full(cw->shobj, sig, src, cb, (void*)data);
 }
 
+/* decide once per frame whether pending damage is cheaper to upload as the
+ * separate rects the tiler holds or as their bounding box: each extra rect
+ * is charged an overhead which grows with the window size, so damage on
+ * large windows is merged more readily than on small ones */
+static void
+_e_comp_object_damage_coalesce(E_Comp_Object *cw)
+{
+   unsigned long long box_area, rect_cost, cost = 0;
+   Eina_Rectangle *box = &cw->damage_box;
+   Eina_Rectangle *r;
+   Eina_Iterator *it;
+   unsigned int rects = 0;
+   int tw, th;
+
+   if ((cw->updates_full) || (cw->update_count <= 1)) return;
+   /* the tiler already merged overlapping damage, so count what it holds */
+   it = eina_tiler_iterator_new(cw->updates);
+   EINA_ITERATOR_FOREACH(it, r)
+     {
+        cost += (unsigned long long)r->w * r->h;
+        rects++;
+     }
+   eina_iterator_free(it);
+   if (rects <= 1) return;
+   eina_tiler_area_size_get(cw->updates, &tw, &th);
+   rect_cost = MAX(DAMAGE_RECT_COST, ((unsigned long long)tw * th) / 512);
+   box_area = (unsigned long long)box->w * box->h;
+   if (box_area > cost + (rects - 1) * rect_cost) return;
+
+   eina_tiler_clear(cw->updates);
+   eina_tiler_rect_add(cw->updates, box);
+   RENDER_DEBUG("DAMAGE COALESCE %p: %d,%d %dx%d", cw->ec, box->x, box->y, box->w, box->h);
+}
+
 E_API void
 e_comp_object_damage(Evas_Object *obj, int x, int y, int w, int h)
 {
@@ -3723,6 +3862,8 @@ e_comp_object_damage(Evas_Object *obj, int x, int y, int w, int h)
    rect.x = x, rect.y = y;
    rect.w = w, rect.h = h;
    evas_object_smart_callback_call(obj, "damage", &rect);
+   if ((cw->damage_time <= 0.0) && e_comp_trace_enabled_get())
+     cw->damage_time = ecore_time_get();
    if (e_comp->nocomp)
      {
         cw->nocomp_need_update = EINA_TRUE;
@@ -3750,6 +3891,7 @@ e_comp_object_damage(Evas_Object *obj, int x, int y, int w, int h)
         eina_tiler_area_size_set(cw->updates, cw->ec->client.w, cw->ec->client.h);
         x = 0, y = 0;
         tw = cw->ec->client.w, th = cw->ec->client.h;
+        cw->update_count = 0;
      }
    if ((!x) && (!y) && (w == tw) && (h == th))
      {
@@ -3765,12 +3907,18 @@ e_comp_object_damage(Evas_Object *obj, int x, int y, int w, int h)
         eina_tiler_clear(cw->updates);
         cw->update_count = cw->updates_full = 1;
         eina_tiler_rect_add(cw->updates, &(Eina_Rectangle){0, 0, tw, th});
+        cw->damage_pixels += (unsigned long long)w * h;
         RENDER_DEBUG("DAMAGE MAX: %dx%d", tw, th);
      }
    else
      {
         eina_tiler_rect_add(cw->updates, &(Eina_Rectangle){x, y, w, h});
         RENDER_DEBUG("DAMAGE: %d,%d %dx%d", x, y, w, h);
+        cw->damage_pixels += (unsigned long long)w * h;
+        if (cw->update_count == 1)
+          EINA_RECTANGLE_SET(&cw->damage_box, x, y, w, h);
+        else
+          eina_rectangle_union(&cw->damage_box, &(Eina_Rectangle){x, y, w, h});
      }
    cw->updates_exist = 1;
    if (!e_object_is_del(E_OBJECT(cw->ec)))
@@ -3784,6 +3932,28 @@ e_comp_object_damage_exists(Evas_Object *obj)
    return cw->updates_exist || cw->updates_full;
 }
 
+static Eina_Bool
+_e_comp_object_render_update_queued(const E_Comp_Object *cw)
+{
+   return (cw->update_idx < eina_array_count(e_comp->updates)) &&
+          (eina_array_data_get(e_comp->updates, cw->update_idx) == cw->ec);
+}
+
+static void
+_e_comp_object_render_update_unqueue(E_Comp_Object *cw)
+{
+   E_Comp_Object *lcw;
+   E_Client *last;
+
+   if (!_e_comp_object_render_update_queued(cw)) return;
+   /* swap the last entry into this slot so removal stays O(1) */
+   last = eina_array_pop(e_comp->updates);
+   if (last == cw->ec) return;
+   eina_array_data_set(e_comp->updates, cw->update_idx, last);
+   lcw = evas_object_smart_data_get(last->frame);
+   if (lcw) lcw->update_idx = cw->update_idx;
+}
+
 E_API void
 e_comp_object_render_update_add(Evas_Object *obj)
 {
@@ -3798,7 +3968,11 @@ e_comp_object_render_update_add(Evas_Object *obj)
    if (!cw->update)
      {
         cw->update = 1;
-        e_comp->updates = eina_list_append(e_comp->updates, cw->ec);
+        if (!_e_comp_object_render_update_queued(cw))
+          {
+             cw->update_idx = eina_array_count(e_comp->updates);
+             eina_array_push(e_comp->updates, cw->ec);
+          }
      }
    e_comp_render_queue();
 }
@@ -3813,7 +3987,7 @@ e_comp_object_render_update_del(Evas_Object *obj)
    cw->update = 0;
    /* this gets called during comp animating to clear the update flag */
    if (e_comp->grabbed) return;
-   e_comp->updates = eina_list_remove(e_comp->updates, cw->ec);
+   _e_comp_object_render_update_unqueue(cw);
 }
 
 E_API void
@@ -4042,8 +4216,9 @@ e_comp_object_dirty(Evas_Object *obj)
    Eina_List *ll;
    Evas_Object *o;
    int w, h;
-   Eina_Bool dirty, visible, alpha;
+   Eina_Bool dirty, visible, alpha, throttled = EINA_FALSE;
    int bx, by, bxx, byy;
+   unsigned long long upload = 0;
 
    API_ENTRY;
    /* only actually dirty if pixmap is available */
@@ -4062,13 +4237,27 @@ e_comp_object_dirty(Evas_Object *obj)
    alpha = evas_object_image_alpha_get(cw->obj);
    EINA_LIST_FOREACH(cw->obj_mirror, ll, o)
      {
+        E_Comp_Object_Mirror_Throttle *mt;
+        int ow, oh;
+
         //evas_object_image_border_set(o, bx, by, bxx, byy);
         //evas_object_image_border_center_fill_set(o, EVAS_BORDER_FILL_SOLID);
+        mt = evas_object_data_get(o, "comp_mirror_throttle");
+        evas_object_image_size_get(o, &ow, &oh);
         if (!dirty)
           evas_object_image_data_set(o, NULL);
         evas_object_image_size_set(o, w, h);
-        evas_object_image_pixels_dirty_set(o, dirty);
         evas_object_image_alpha_set(o, alpha);
+        /* throttled mirrors only collect damage here; a resize can't wait */
+        if (mt && dirty)
+          {
+             if ((ow != w) || (oh != h))
+               _e_comp_object_mirror_refresh(cw, o, mt);
+             else
+               mt->stale = throttled = EINA_TRUE;
+             continue;
+          }
+        evas_object_image_pixels_dirty_set(o, dirty);
         visible |= evas_object_visible_get(o);
      }
    if (!dirty)
@@ -4125,13 +4314,18 @@ e_comp_object_dirty(Evas_Object *obj)
    }
 
    e_comp_object_native_surface_set(obj, 1);
+   _e_comp_object_damage_coalesce(cw);
    it = eina_tiler_iterator_new(cw->updates);
    EINA_ITERATOR_FOREACH(it, rect)
      {
+        upload += (unsigned long long)rect->w * rect->h;
         RENDER_DEBUG("UPDATE ADD [%p]: %d %d %dx%d", cw->ec, rect->x, rect->y, rect->w, rect->h);
         evas_object_image_data_update_add(cw->obj, rect->x, rect->y, rect->w, rect->h);
         EINA_LIST_FOREACH(cw->obj_mirror, ll, o)
-          evas_object_image_data_update_add(o, rect->x, rect->y, rect->w, rect->h);
+          {
+             if (evas_object_data_get(o, "comp_mirror_throttle")) continue;
+             evas_object_image_data_update_add(o, rect->x, rect->y, rect->w, rect->h);
+          }
         if (cw->pending_updates)
           eina_tiler_rect_add(cw->pending_updates, rect);
      }
@@ -4144,27 +4338,31 @@ e_comp_object_dirty(Evas_Object *obj)
         cw->updates = eina_tiler_new(w, h);
         eina_tiler_tile_size_set(cw->updates, 1, 1);
      }
+   RENDER_DEBUG("DAMAGE PIXELS [%p]: %llu damaged, %llu uploaded", cw->ec, cw->damage_pixels, upload);
+   e_comp->update_stats.damage_pixels += cw->damage_pixels;
+   e_comp->update_stats.upload_pixels += upload;
+   cw->damage_pixels = 0;
    cw->update_count = cw->updates_full = cw->updates_exist = 0;
    evas_object_smart_callback_call(obj, "dirty", NULL);
+   if (throttled)
+     _e_comp_object_mirror_throttle_queue(cw);
    if (cw->real_hid || cw->visible || (!visible) || (!cw->pending_updates) || cw->native) return;
    /* force render if main object is hidden but mirrors are visible */
    RENDER_DEBUG("FORCING RENDER %p", cw->ec);
    e_comp_object_render(obj);
 }
 
-E_API Eina_Bool
-e_comp_object_render(Evas_Object *obj)
+static Eina_Bool
+_e_comp_object_render(E_Comp_Object *cw, Evas_Object *obj)
 {
    Eina_Iterator *it = NULL;
-   Eina_Rectangle *r;
+   Eina_Rectangle *r, *rects, full;
    Eina_List *l;
    Evas_Object *o;
    int stride, pw, ph;
-   unsigned int *pix, *srcpix;
+   unsigned int *pix, *srcpix, i, num, fetches = 0;
    Eina_Bool ret = EINA_FALSE;
 
-   API_ENTRY EINA_FALSE;
-
    EINA_SAFETY_ON_NULL_RETURN_VAL(cw->ec, EINA_FALSE);
    if (cw->ec->input_only) return EINA_TRUE;
    e_comp_object_render_update_del(obj);
@@ -4193,29 +4391,52 @@ e_comp_object_render(Evas_Object *obj)
      }
 
    it = eina_tiler_iterator_new(cw->pending_updates);
-   if (e_pixmap_image_is_argb(cw->ec->pixmap))
+   num = 0;
+   rects = render_rects;
+   EINA_ITERATOR_FOREACH(it, r)
      {
-        pix = e_pixmap_image_data_get(cw->ec->pixmap);
-        EINA_ITERATOR_FOREACH(it, r)
+        if (num == render_rects_size)
           {
-             E_RECTS_CLIP_TO_RECT(r->x, r->y, r->w, r->h, 0, 0, pw, ph);
-             /* get pixmap data from rect region on display server into memory */
-             ret = e_pixmap_image_draw(cw->ec->pixmap, r);
-             if (!ret)
+             Eina_Rectangle *tmp;
+
+             tmp = realloc(render_rects, (render_rects_size + 32) * sizeof(Eina_Rectangle));
+             if (!tmp)
                {
-                  WRN("UPDATE [%p]: %i %i %ix%i FAIL(%u)!!!!!!!!!!!!!!!!!", cw->ec, r->x, r->y, r->w, r->h, cw->failures);
-                  if (++cw->failures < FAILURE_MAX)
-                    e_comp_object_damage(obj, 0, 0, pw, ph);
-                  else
-                    {
-                       DELD(cw->ec, 2);
-                       e_object_del(E_OBJECT(cw->ec));
-                       return EINA_FALSE;
-                    }
+                  /* dropping rects would leave stale pixels, so update the
+                   * whole surface instead */
+                  WRN("RENDER [%p]: out of rects, updating it all", cw->ec);
+                  EINA_RECTANGLE_SET(&full, 0, 0, pw, ph);
+                  rects = &full;
+                  num = 1;
                   break;
                }
-             RENDER_DEBUG("UPDATE [%p] %i %i %ix%i", cw->ec, r->x, r->y, r->w, r->h);
+             render_rects = tmp;
+             render_rects_size += 32;
+          }
+        render_rects[num] = *r;
+        E_RECTS_CLIP_TO_RECT(render_rects[num].x, render_rects[num].y,
+                             render_rects[num].w, render_rects[num].h, 0, 0, pw, ph);
+        if ((render_rects[num].w > 0) && (render_rects[num].h > 0)) num++;
+     }
+   /* get pixmap data from damaged regions on display server into memory */
+   ret = e_pixmap_image_draw_rects(cw->ec->pixmap, rects, num, &fetches);
+   if (!ret)
+     {
+        WRN("UPDATE [%p]: %u rects FAIL(%u)!!!!!!!!!!!!!!!!!", cw->ec, num, cw->failures);
+        if (++cw->failures < FAILURE_MAX)
+          e_comp_object_damage(obj, 0, 0, pw, ph);
+        else
+          {
+             eina_iterator_free(it);
+             DELD(cw->ec, 2);
+             e_object_del(E_OBJECT(cw->ec));
+             return EINA_FALSE;
           }
+     }
+   RENDER_DEBUG("UPDATE [%p]: %u rects in %u fetches", cw->ec, num, fetches);
+   if (e_pixmap_image_is_argb(cw->ec->pixmap))
+     {
+        pix = e_pixmap_image_data_get(cw->ec->pixmap);
         if (!it) pix = NULL;
         goto end;
      }
@@ -4223,23 +4444,9 @@ e_comp_object_render(Evas_Object *obj)
    pix = evas_object_image_data_get(cw->obj, EINA_TRUE);
    stride = evas_object_image_stride_get(cw->obj);
    srcpix = e_pixmap_image_data_get(cw->ec->pixmap);
-   EINA_ITERATOR_FOREACH(it, r)
+   for (i = 0; ret && (i < num); i++)
      {
-        E_RECTS_CLIP_TO_RECT(r->x, r->y, r->w, r->h, 0, 0, pw, ph);
-        ret = e_pixmap_image_draw(cw->ec->pixmap, r);
-        if (!ret)
-          {
-             WRN("UPDATE [%p]: %i %i %ix%i FAIL(%u)!!!!!!!!!!!!!!!!!", cw->ec, r->x, r->y, r->w, r->h, cw->failures);
-             if (++cw->failures < FAILURE_MAX)
-               e_comp_object_damage(obj, 0, 0, pw, ph);
-             else
-               {
-                  DELD(cw->ec, 3);
-                  e_object_del(E_OBJECT(cw->ec));
-                  return EINA_FALSE;
-               }
-             break;
-          }
+        r = &rects[i];
         e_pixmap_image_data_argb_convert(cw->ec->pixmap, pix, srcpix, r, stride);
         RENDER_DEBUG("UPDATE [%p]: %d %d %dx%d -- pix = %p", cw->ec, r->x, r->y, r->w, r->h, pix);
      }
@@ -4255,6 +4462,22 @@ end:
    return ret;
 }
 
+E_API Eina_Bool
+e_comp_object_render(Evas_Object *obj)
+{
+   Eina_Bool ret;
+   int64_t win;
+   double trace;
+
+   API_ENTRY EINA_FALSE;
+
+   trace = e_comp_trace_begin();
+   win = cw->ec ? e_pixmap_window_get(cw->ec->pixmap) : 0;
+   ret = _e_comp_object_render(cw, obj);
+   e_comp_trace_end(E_COMP_TRACE_OBJECT_RENDER, trace, win);
+   return ret;
+}
+
 E_API Evas_Object *
 e_comp_object_agent_add(Evas_Object *obj)
 {
@@ -4355,6 +4578,39 @@ e_comp_object_util_mirror_add(Evas_Object *obj)
    return o;
 }
 
+/* limit how often a mirror from e_comp_object_util_mirror_add() picks up damage:
+ * updates are coalesced and applied at most once per interval while the mirror
+ * is visible; an interval <= 0 makes the mirror live again
+ */
+E_API void
+e_comp_object_util_mirror_throttle_set(Evas_Object *mirror, double interval)
+{
+   E_Comp_Object *cw;
+   E_Comp_Object_Mirror_Throttle *mt;
+
+   EINA_SAFETY_ON_NULL_RETURN(mirror);
+   cw = evas_object_data_get(mirror, "comp_mirror");
+   if ((!cw) || (!eina_list_data_find(cw->obj_mirror, mirror))) return;
+   mt = evas_object_data_get(mirror, "comp_mirror_throttle");
+   if (interval <= 0.0)
+     {
+        if (!mt) return;
+        evas_object_data_del(mirror, "comp_mirror_throttle");
+        if (mt->stale)
+          _e_comp_object_mirror_refresh(cw, mirror, mt);
+        free(mt);
+        return;
+     }
+   if (!mt)
+     {
+        mt = E_NEW(E_Comp_Object_Mirror_Throttle, 1);
+        if (!mt) return;
+        mt->last = ecore_loop_time_get();
+        evas_object_data_set(mirror, "comp_mirror_throttle", mt);
+     }
+   mt->interval = interval;
+}
+
 //////////////////////////////////////////////////////
 
 E_API Eina_Bool
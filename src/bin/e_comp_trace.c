@@ -0,0 +1,151 @@
+#include "e.h"
+
+/* must be a power of 2 */
+#define TRACE_SIZE 16384
+
+typedef struct _E_Comp_Trace_Event
+{
+   double start;
+   double end;
+   int64_t win;
+   E_Comp_Trace_Stage stage;
+} E_Comp_Trace_Event;
+
+static const char *_e_comp_trace_names[E_COMP_TRACE_LAST] =
+{
+   "client_eval",
+   "client_update",
+   "object_render",
+   "shapes",
+   "evas_render",
+   "present"
+};
+
+/* only the main loop records events, so a single writer index is enough */
+static E_Comp_Trace_Event *_e_comp_trace_events = NULL;
+static unsigned int _e_comp_trace_pos = 0;
+static Eina_Bool _e_comp_trace_enabled = EINA_FALSE;
+static const char *_e_comp_trace_file = NULL;
+
+EINTERN int
+e_comp_trace_init(void)
+{
+   _e_comp_trace_file = getenv("E_COMP_TRACE");
+   if (_e_comp_trace_file && _e_comp_trace_file[0])
+     e_comp_trace_enabled_set(EINA_TRUE);
+   return 1;
+}
+
+EINTERN int
+e_comp_trace_shutdown(void)
+{
+   if (_e_comp_trace_enabled && _e_comp_trace_file && _e_comp_trace_file[0])
+     {
+        if (!e_comp_trace_dump(_e_comp_trace_file))
+          ERR("Cannot write frame trace to '%s'", _e_comp_trace_file);
+     }
+   _e_comp_trace_enabled = EINA_FALSE;
+   E_FREE(_e_comp_trace_events);
+   _e_comp_trace_pos = 0;
+   return 1;
+}
+
+E_API void
+e_comp_trace_enabled_set(Eina_Bool enabled)
+{
+   enabled = !!enabled;
+   if (enabled == _e_comp_trace_enabled) return;
+   if (enabled && (!_e_comp_trace_events))
+     {
+        _e_comp_trace_events = E_NEW(E_Comp_Trace_Event, TRACE_SIZE);
+        if (!_e_comp_trace_events) return;
+        _e_comp_trace_pos = 0;
+     }
+   _e_comp_trace_enabled = enabled;
+}
+
+E_API Eina_Bool
+e_comp_trace_enabled_get(void)
+{
+   return _e_comp_trace_enabled;
+}
+
+E_API double
+e_comp_trace_begin(void)
+{
+   if (!_e_comp_trace_enabled) return 0.0;
+   return ecore_time_get();
+}
+
+E_API void
+e_comp_trace_end(E_Comp_Trace_Stage stage, double start, int64_t win)
+{
+   E_Comp_Trace_Event *ev;
+
+   if ((!_e_comp_trace_enabled) || (start <= 0.0)) return;
+   if (stage >= E_COMP_TRACE_LAST) return;
+   ev = &_e_comp_trace_events[_e_comp_trace_pos++ & (TRACE_SIZE - 1)];
+   ev->start = start;
+   ev->end = ecore_time_get();
+   ev->win = win;
+   ev->stage = stage;
+}
+
+E_API char *
+e_comp_trace_json_get(void)
+{
+   Eina_Strbuf *buf;
+   unsigned int i, first, count;
+   int pid = getpid();
+   char *ret;
+
+   buf = eina_strbuf_new();
+   if (!buf) return NULL;
+   eina_strbuf_append(buf, "{\"traceEvents\":[");
+   count = MIN(_e_comp_trace_pos, TRACE_SIZE);
+   first = _e_comp_trace_pos - count;
+   for (i = 0; _e_comp_trace_events && (i < count); i++)
+     {
+        E_Comp_Trace_Event *ev;
+
+        ev = &_e_comp_trace_events[(first + i) & (TRACE_SIZE - 1)];
+        eina_strbuf_append_printf(buf,
+          "%s{\"name\":\"%s\",\"cat\":\"comp\",\"ph\":\"X\","
+          "\"ts\":%.0f,\"dur\":%.0f,\"pid\":%d,\"tid\":%d",
+          i ? "," : "", _e_comp_trace_names[ev->stage],
+          ev->start * 1000000.0, (ev->end - ev->start) * 1000000.0,
+          /* latencies span frames, keep them off the stage timeline */
+          pid, (ev->stage == E_COMP_TRACE_PRESENT) ? 2 : 1);
+        if (ev->win)
+          eina_strbuf_append_printf(buf, ",\"args\":{\"win\":\"0x%"PRIx64"\"}", (uint64_t)ev->win);
+        eina_strbuf_append_char(buf, '}');
+     }
+   eina_strbuf_append(buf, "],\"displayTimeUnit\":\"ms\"}\n");
+   ret = eina_strbuf_string_steal(buf);
+   eina_strbuf_free(buf);
+   return ret;
+}
+
+E_API Eina_Bool
+e_comp_trace_dump(const char *file)
+{
+   FILE *f;
+   char *json;
+   size_t len;
+   Eina_Bool ret;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(file, EINA_FALSE);
+   json = e_comp_trace_json_get();
+   if (!json) return EINA_FALSE;
+   f = fopen(file, "w");
+   if (!f)
+     {
+        free(json);
+        return EINA_FALSE;
+     }
+   len = strlen(json);
+   ret = (fwrite(json, 1, len, f) == len);
+   if (fclose(f)) ret = EINA_FALSE;
+   free(json);
+   return ret;
+}
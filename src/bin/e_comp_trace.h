@@ -0,0 +1,33 @@
+#ifdef E_TYPEDEFS
+
+typedef enum _E_Comp_Trace_Stage
+{
+   E_COMP_TRACE_CLIENT_EVAL, // e_client_idler_before()
+   E_COMP_TRACE_CLIENT_UPDATE, // client pixmap updates for a frame
+   E_COMP_TRACE_OBJECT_RENDER, // e_comp_object_render() of one client
+   E_COMP_TRACE_SHAPES, // x11 input shape update
+   E_COMP_TRACE_EVAS_RENDER, // canvas render pre to flush post
+   E_COMP_TRACE_PRESENT, // first damage of a client until it is presented
+   E_COMP_TRACE_LAST
+} E_Comp_Trace_Stage;
+
+#else
+#ifndef E_COMP_TRACE_H
+#define E_COMP_TRACE_H
+
+/* frame timing trace: stages are recorded into a fixed ring buffer which can
+ * be dumped as chrome trace event json. set E_COMP_TRACE to a file path to
+ * trace from startup and write the buffer there on shutdown */
+
+EINTERN int e_comp_trace_init(void);
+EINTERN int e_comp_trace_shutdown(void);
+
+E_API void e_comp_trace_enabled_set(Eina_Bool enabled);
+E_API Eina_Bool e_comp_trace_enabled_get(void);
+E_API double e_comp_trace_begin(void);
+E_API void e_comp_trace_end(E_Comp_Trace_Stage stage, double start, int64_t win);
+E_API char *e_comp_trace_json_get(void);
+E_API Eina_Bool e_comp_trace_dump(const char *file);
+
+#endif
+#endif
@@ -50,6 +50,7 @@ E_API int E_EVENT_CONFIG_LOADED = 0;
 
 static E_Dialog *_e_config_error_dialog = NULL;
 static Eina_List *handlers = NULL;
+static unsigned int _e_config_generation = 0;
 
 typedef struct _E_Color_Class
 {
@@ -249,6 +250,8 @@ _e_config_edd_init(Eina_Bool old)
 #define D _e_config_module_edd
    E_CONFIG_VAL(D, T, name, STR);
    E_CONFIG_VAL(D, T, enabled, UCHAR);
+   E_CONFIG_VAL(D, T, priority, UCHAR);
+   EET_DATA_DESCRIPTOR_ADD_LIST_STRING(D, T, "actions", actions);
 
    _e_config_font_default_edd = E_CONFIG_DD_NEW("E_Font_Default",
                                                 E_Font_Default);
@@ -974,6 +977,7 @@ e_config_load(void)
 {
    int reload = 0;
 
+   _e_config_generation++;
    e_config = e_config_domain_load("e", _e_config_edd);
    if (e_config)
      {
@@ -1717,6 +1721,14 @@ e_config_load(void)
    ecore_event_add(E_EVENT_CONFIG_LOADED, NULL, NULL, NULL);
 }
 
+/* bumped whenever e_config is loaded, so anything derived from its
+ * lists can tell they were replaced */
+EINTERN unsigned int
+e_config_generation_get(void)
+{
+   return _e_config_generation;
+}
+
 E_API int
 e_config_save(void)
 {
@@ -2367,6 +2379,7 @@ _e_config_free(E_Config *ecf)
    EINA_LIST_FREE(ecf->modules, em)
      {
         if (em->name) eina_stringshare_del(em->name);
+        E_FREE_LIST(em->actions, eina_stringshare_del);
         E_FREE(em);
      }
    EINA_LIST_FREE(ecf->font_fallbacks, eff)
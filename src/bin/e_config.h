@@ -480,6 +480,8 @@ struct _E_Config_Module
 {
    const char   *name;
    unsigned char enabled;
+   unsigned char priority; // E_Module_Priority, as last declared by the module
+   Eina_List    *actions; // actions a module loaded late registers
 };
 
 struct _E_Config_Binding_Mouse
@@ -639,6 +641,7 @@ EINTERN int                   e_config_init(void);
 EINTERN int                   e_config_shutdown(void);
 
 E_API void                     e_config_load(void);
+EINTERN unsigned int          e_config_generation_get(void);
 
 E_API int                      e_config_save(void);
 E_API void                     e_config_save_flush(void);
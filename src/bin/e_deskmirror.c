@@ -27,6 +27,8 @@ typedef struct E_Smart_Data
    E_Desk *desk;
    E_Object_Delfn *desk_delfn;
 
+   double mirror_interval; // update throttle for client mirrors, 0 for live
+
    Eina_Bool pager E_BITFIELD;
    Eina_Bool taskbar E_BITFIELD;
 
@@ -616,6 +618,8 @@ _comp_object_check(Mirror *m)
      {
         m->mirror = e_comp_object_util_mirror_add(m->comp_object);
         if (!m->mirror) return EINA_FALSE;
+        if (m->ec && (m->sd->mirror_interval > 0.0))
+          e_comp_object_util_mirror_throttle_set(m->mirror, m->sd->mirror_interval);
      }
    evas_object_smart_callback_del(m->comp_object, "dirty", _comp_object_dirty);
    if (m->added) return EINA_TRUE;
@@ -719,6 +723,8 @@ _e_deskmirror_mirror_add(E_Smart_Data *sd, Evas_Object *obj)
      {
         o = e_comp_object_util_mirror_add(obj);
         evas_object_name_set(o, "m->mirror");
+        if (o && ec && (sd->mirror_interval > 0.0))
+          e_comp_object_util_mirror_throttle_set(o, sd->mirror_interval);
      }
    m = calloc(1, sizeof(Mirror));
    m->comp_object = obj;
@@ -986,6 +992,31 @@ e_deskmirror_util_wins_print(Evas_Object *obj)
      }
 }
 
+/* limit client mirrors to one update per interval, for previews where
+ * live updates aren't worth the cost; 0 restores live mirrors
+ */
+E_API void
+e_deskmirror_mirror_throttle_set(Evas_Object *obj, double interval)
+{
+   Mirror *m;
+
+   API_ENTRY(obj);
+
+   interval = MAX(interval, 0.0);
+   if (EINA_DBL_EQ(sd->mirror_interval, interval)) return;
+   sd->mirror_interval = interval;
+   EINA_INLIST_FOREACH(sd->mirrors, m)
+     {
+        Mirror_Border *mb;
+
+        if ((!m->ec) || (!m->mirror)) continue;
+        if (e_util_strcmp(evas_object_type_get(m->mirror), "mirror_border")) continue;
+        mb = evas_object_smart_data_get(m->mirror);
+        if (mb->mirror)
+          e_comp_object_util_mirror_throttle_set(mb->mirror, interval);
+     }
+}
+
 E_API void
 e_deskmirror_update_force(Evas_Object *obj)
 {
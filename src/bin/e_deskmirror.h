@@ -10,6 +10,7 @@ E_API void e_deskmirror_coord_virtual_to_canvas(Evas_Object *obj, Evas_Coord vx,
 E_API E_Desk *e_deskmirror_desk_get(Evas_Object *obj);
 E_API void e_deskmirror_util_wins_print(Evas_Object *obj);
 E_API void e_deskmirror_update_force(Evas_Object *obj);
+E_API void e_deskmirror_mirror_throttle_set(Evas_Object *obj, double interval);
 //#define DESKMIRROR_TEST
 
 #endif
@@ -38,6 +38,8 @@ typedef struct _E_Fm2_Action            E_Fm2_Action;
 typedef struct _E_Fm2_Client            E_Fm2_Client;
 typedef struct _E_Fm2_Uri               E_Fm2_Uri;
 typedef struct _E_Fm2_Context_Menu_Data E_Fm2_Context_Menu_Data;
+typedef struct _E_Fm2_Typebuf_Index    E_Fm2_Typebuf_Index;
+typedef struct _E_Fm2_Typebuf_Key      E_Fm2_Typebuf_Key;
 
 struct _E_Fm2_Smart_Data
 {
@@ -120,8 +122,6 @@ struct _E_Fm2_Smart_Data
    struct
    {
       Evas_Object *obj, *obj2;
-      Eina_List   *last_insert;
-      Eina_List  **list_index;
       int          iter;
    } tmp;
 
@@ -139,6 +139,7 @@ struct _E_Fm2_Smart_Data
       const char  *start;
       Ecore_Timer *timer;
       unsigned int wildcard;
+      E_Fm2_Typebuf_Index *index;
       Eina_Bool    setting E_BITFIELD;
       Eina_Bool    disabled E_BITFIELD;
    } typebuf;
@@ -172,6 +173,24 @@ struct _E_Fm2_Smart_Data
    Efreet_Desktop      *desktop;
 };
 
+/* case folded labels and file names of all icons in a view, sorted, so
+ * typebuf prefixes are a binary search away. trigrams of the keys are
+ * only indexed once a pattern starting with a wildcard shows up. */
+struct _E_Fm2_Typebuf_Key
+{
+   const char  *key;
+   E_Fm2_Icon  *ic;
+   unsigned int order;
+};
+
+struct _E_Fm2_Typebuf_Index
+{
+   E_Fm2_Typebuf_Key *keys;
+   unsigned int       count;
+   char              *strings;
+   Eina_Hash         *trigrams;
+};
+
 struct _E_Fm2_Region
 {
    E_Fm2_Smart_Data *sd;
@@ -198,6 +217,12 @@ struct _E_Fm2_Icon
    E_Dialog         *dialog;
 
    E_Fm2_Icon_Info   info;
+   struct
+   {
+      const char *src; // label the keys were made from
+      const char *ext; // points into src
+      char       *label; // src lowercased for no_case sorting
+   } sort;
    E_Fm2_Mount      *mount; // for dnd into unmounted dirs
    Ecore_Timer      *mount_timer; // autounmount in 15s
 
@@ -325,6 +350,7 @@ static E_Fm2_Icon   *_e_fm2_typebuf_match(Evas_Object *obj, int next);
 static void          _e_fm2_typebuf_complete(Evas_Object *obj);
 static void          _e_fm2_typebuf_char_append(Evas_Object *obj, const char *ch);
 static void          _e_fm2_typebuf_char_backspace(Evas_Object *obj);
+static void          _e_fm2_typebuf_index_clear(E_Fm2_Smart_Data *sd);
 
 static void          _e_fm2_cb_dnd_enter(void *data, const char *type, void *event);
 static void          _e_fm2_cb_dnd_move(void *data, const char *type, void *event);
@@ -344,6 +370,7 @@ static void          _e_fm2_cb_mouse_move(void *data, Evas *e, Evas_Object *obj,
 static void          _e_fm2_cb_scroll_job(void *data);
 static void          _e_fm2_cb_resize_job(void *data);
 static int           _e_fm2_cb_icon_sort(const void *data1, const void *data2);
+static void          _e_fm2_icon_sort_key_clear(E_Fm2_Icon *ic);
 static Eina_Bool     _e_fm2_cb_scan_timer(void *data);
 static Eina_Bool     _e_fm2_cb_sort_idler(void *data);
 static Eina_Bool     _e_fm2_cb_theme(void *data, int type EINA_UNUSED, void *event EINA_UNUSED);
@@ -678,6 +705,7 @@ static Eina_Bool
 _e_fm2_mime_clear_cb(void *data EINA_UNUSED)
 {
    efreet_mime_type_cache_clear();
+   e_fm_mime_filename_cache_flush();
    return ECORE_CALLBACK_RENEW;
 }
 
@@ -893,6 +921,7 @@ e_fm2_shutdown(void)
    e_fm2_custom_file_shutdown();
    _e_storage_volume_edd_shutdown();
    e_fm2_op_registry_shutdown();
+   e_fm_mime_filename_cache_flush();
    efreet_mime_shutdown();
    ecore_shutdown();
    eina_shutdown();
@@ -2739,7 +2768,6 @@ _e_fm2_client_monitor_list_end(Evas_Object *obj)
         ecore_idler_del(sd->sort_idler);
         sd->sort_idler = NULL;
      }
-   E_FREE(sd->tmp.list_index);
    _e_fm2_queue_free(obj);
    _e_fm2_obj_icons_place(sd);
    _e_fm2_live_process_begin(obj);
@@ -2785,6 +2813,98 @@ _e_fm2_file_force_update(const char *path)
    free(dir);
 }
 
+static unsigned char *
+_e_fm2_client_finfo_decode(unsigned char *p, E_Fm2_Finfo *finf, const char **path)
+{
+   /* NOTE: i am NOT converting this data to portable arch/os independent
+    * format. i am ASSUMING e_fm_main and e are local and built together
+    * and thus this will work. if this ever changes this here needs to
+    * change */
+   memcpy(&(finf->st), p, sizeof(struct stat));
+   p += sizeof(struct stat);
+
+   finf->broken_link = p[0];
+   p += 1;
+
+   *path = (char *)p;
+   p += strlen(*path) + 1;
+
+   finf->lnk = (char *)p;
+   p += strlen(finf->lnk) + 1;
+
+   finf->rlnk = (char *)p;
+   p += strlen(finf->rlnk) + 1;
+   return p;
+}
+
+static void
+_e_fm2_client_listing_add(Evas_Object *obj, E_Fm2_Smart_Data *sd, const char *path, E_Fm2_Finfo *finf, Eina_Bool end)
+{
+   const char *file;
+
+   if (!sd->scan_timer)
+     {
+        sd->scan_timer =
+          ecore_timer_loop_add(0.5,
+                          _e_fm2_cb_scan_timer,
+                          sd->obj);
+        sd->busy_count++;
+        if (sd->busy_count == 1)
+          edje_object_signal_emit(sd->overlay, "e,state,busy,start", "e");
+     }
+   else
+     {
+        if ((eina_list_count(sd->icons) > 50) && (ecore_timer_interval_get(sd->scan_timer) < 1.5))
+          {
+             /* increase timer interval when loading large directories to
+              * dramatically improve load times
+              */
+             ecore_timer_interval_set(sd->scan_timer, 1.5);
+             ecore_timer_loop_reset(sd->scan_timer);
+          }
+     }
+   if (path[0] != 0)
+     {
+        file = ecore_file_file_get(path);
+        if ((!strcmp(file, ".order")))
+          sd->order_file = EINA_TRUE;
+        else
+          {
+             unsigned int n;
+
+             n = eina_list_count(sd->queue) + eina_list_count(sd->icons);
+             if (!((file[0] == '.') &&
+                   (!sd->show_hidden_files)))
+               {
+                  char buf[1024];
+
+                  _e_fm2_file_add(obj, file,
+                                  sd->order_file,
+                                  NULL, 0, finf);
+                  if (n - sd->overlay_count > 150)
+                    {
+                       sd->overlay_count = n + 1;
+                       snprintf(buf, sizeof(buf), P_("%u file", "%u files", sd->overlay_count), sd->overlay_count);
+                       edje_object_part_text_set(sd->overlay, "e.text.busy_label", buf);
+                    }
+               }
+          }
+     }
+   if (end)    /* end of scan */
+     {
+        sd->listing = EINA_FALSE;
+        if (sd->scan_timer)
+          {
+             ecore_timer_interval_set(sd->scan_timer, 0.0001);
+             ecore_timer_loop_reset(sd->scan_timer);
+          }
+        else
+          {
+             _e_fm2_client_monitor_list_end(obj);
+          }
+     }
+}
+
 E_API void
 e_fm2_client_data(Ecore_Ipc_Event_Client_Data *e)
 {
@@ -2812,9 +2932,7 @@ e_fm2_client_data(Ecore_Ipc_Event_Client_Data *e)
      {
         unsigned char *p;
         char *evdir;
-        const char *dir, *path, *lnk, *rlnk, *file;
-        struct stat st;
-        int broken_link;
+        const char *dir, *path;
         E_Fm2_Smart_Data *sd;
 
         if ((_e_fm2_list_walking > 0) &&
@@ -2839,29 +2957,7 @@ e_fm2_client_data(Ecore_Ipc_Event_Client_Data *e)
            {
               E_Fm2_Finfo finf;
 
-              p = e->data;
-              /* NOTE: i am NOT converting this data to portable arch/os independent
-               * format. i am ASSUMING e_fm_main and e are local and built together
-               * and thus this will work. if this ever changes this here needs to
-               * change */
-              memcpy(&st, p, sizeof(struct stat));
-              p += sizeof(struct stat);
-
-              broken_link = p[0];
-              p += 1;
-
-              path = (char *)p;
-              p += strlen(path) + 1;
-
-              lnk = (char *)p;
-              p += strlen(lnk) + 1;
-
-              rlnk = (char *)p;
-
-              memcpy(&(finf.st), &st, sizeof(struct stat));
-              finf.broken_link = broken_link;
-              finf.lnk = lnk;
-              finf.rlnk = rlnk;
+              _e_fm2_client_finfo_decode(e->data, &finf, &path);
 
               evdir = ecore_file_dir_get(path);
               if ((evdir) && (sd->id == e->ref_to) &&
@@ -2888,69 +2984,8 @@ e_fm2_client_data(Ecore_Ipc_Event_Client_Data *e)
                      }
                    /*file add - listing*/
                    if (e->minor == E_FM_OP_FILE_ADD)    /*file add*/
-                     {
-                        if (!sd->scan_timer)
-                          {
-                             sd->scan_timer =
-                               ecore_timer_loop_add(0.5,
-                                               _e_fm2_cb_scan_timer,
-                                               sd->obj);
-                             sd->busy_count++;
-                             if (sd->busy_count == 1)
-                               edje_object_signal_emit(sd->overlay, "e,state,busy,start", "e");
-                          }
-                        else
-                          {
-                             if ((eina_list_count(sd->icons) > 50) && (ecore_timer_interval_get(sd->scan_timer) < 1.5))
-                               {
-                                  /* increase timer interval when loading large directories to
-                                   * dramatically improve load times
-                                   */
-                                  ecore_timer_interval_set(sd->scan_timer, 1.5);
-                                  ecore_timer_loop_reset(sd->scan_timer);
-                               }
-                          }
-                        if (path[0] != 0)
-                          {
-                             file = ecore_file_file_get(path);
-                             if ((!strcmp(file, ".order")))
-                               sd->order_file = EINA_TRUE;
-                             else
-                               {
-                                  unsigned int n;
-
-                                  n = eina_list_count(sd->queue) + eina_list_count(sd->icons);
-                                  if (!((file[0] == '.') &&
-                                        (!sd->show_hidden_files)))
-                                    {
-                                       char buf[1024];
-
-                                       _e_fm2_file_add(obj, file,
-                                                       sd->order_file,
-                                                       NULL, 0, &finf);
-                                       if (n - sd->overlay_count > 150)
-                                         {
-                                            sd->overlay_count = n + 1;
-                                            snprintf(buf, sizeof(buf), P_("%u file", "%u files", sd->overlay_count), sd->overlay_count);
-                                            edje_object_part_text_set(sd->overlay, "e.text.busy_label", buf);
-                                         }
-                                    }
-                               }
-                          }
-                        if (e->response == 2)    /* end of scan */
-                          {
-                             sd->listing = EINA_FALSE;
-                             if (sd->scan_timer)
-                               {
-                                  ecore_timer_interval_set(sd->scan_timer, 0.0001);
-                                  ecore_timer_loop_reset(sd->scan_timer);
-                               }
-                             else
-                               {
-                                  _e_fm2_client_monitor_list_end(obj);
-                               }
-                          }
-                     }
+                     _e_fm2_client_listing_add(obj, sd, path, &finf,
+                                               e->response == 2);
                    break;
                 }
               free(evdir);
@@ -2976,6 +3011,34 @@ e_fm2_client_data(Ecore_Ipc_Event_Client_Data *e)
            }
            break;
 
+           case E_FM_OP_FILE_ADD_BATCH: /*file add - listing batch*/
+           {
+              E_Fm2_Finfo finf;
+              unsigned char *end;
+              int i;
+
+              /* e->ref records of the file add format, all from one dir */
+              if ((sd->id != e->ref_to) || (e->ref < 1)) break;
+              p = e->data;
+              end = p + e->size;
+              _e_fm2_client_finfo_decode(p, &finf, &path);
+              evdir = ecore_file_dir_get(path);
+              if ((!evdir) || (!dir) || (strcmp(dir, evdir)))
+                {
+                   free(evdir);
+                   break;
+                }
+              free(evdir);
+              for (i = 0; (i < e->ref) && (p < end); i++)
+                {
+                   p = _e_fm2_client_finfo_decode(p, &finf, &path);
+                   _e_fm2_client_listing_add(obj, sd, path, &finf,
+                                             (i == (e->ref - 1)) &&
+                                             (e->response == 2));
+                }
+           }
+           break;
+
            case E_FM_OP_FILE_DEL: /*file del*/
 //             printf("E_FM_OP_FILE_DEL\n");
              path = e->data;
@@ -3463,19 +3526,11 @@ _e_fm2_file_add(Evas_Object *obj, const char *file, int unique, Eina_Stringshare
      {
         EINA_LIST_FOREACH(sd->icons, l, ic)
           {
-             if (!strcmp(ic->info.file, file))
-               {
-                  sd->tmp.last_insert = NULL;
-                  return;
-               }
+             if (!strcmp(ic->info.file, file)) return;
           }
         EINA_LIST_FOREACH(sd->queue, l, ic)
           {
-             if (!strcmp(ic->info.file, file))
-               {
-                  sd->tmp.last_insert = NULL;
-                  return;
-               }
+             if (!strcmp(ic->info.file, file)) return;
           }
      }
    /* create icon obj and append to unsorted list */
@@ -3486,14 +3541,9 @@ _e_fm2_file_add(Evas_Object *obj, const char *file, int unique, Eina_Stringshare
           {
              if (ic->queued) abort();
              if (ic->inserted) abort();
-             /* respekt da ordah! */
-             if (sd->order_file)
-               sd->queue = eina_list_append(sd->queue, ic);
-             else
-               {
-                  /* insertion sort it here to spread the sort load into idle time */
-                  sd->queue = eina_list_sorted_insert(sd->queue, _e_fm2_cb_icon_sort, ic);
-               }
+             /* respekt da ordah! - otherwise the whole queue is sorted
+              * when it is merged into the icons */
+             sd->queue = eina_list_append(sd->queue, ic);
              ic->queued = EINA_TRUE;
           }
         else
@@ -3518,8 +3568,8 @@ _e_fm2_file_add(Evas_Object *obj, const char *file, int unique, Eina_Stringshare
                   ic->inserted = EINA_TRUE;
                }
              sd->icons_place = eina_list_append(sd->icons_place, ic);
+             _e_fm2_typebuf_index_clear(sd);
           }
-        sd->tmp.last_insert = NULL;
         sd->iconlist_changed = EINA_TRUE;
      }
 }
@@ -3541,6 +3591,7 @@ _e_fm2_file_del(Evas_Object *obj, const char *file)
              sd->icons = eina_list_remove_list(sd->icons, l);
              ic->inserted = EINA_FALSE;
              sd->icons_place = eina_list_remove(sd->icons_place, ic);
+             _e_fm2_typebuf_index_clear(sd);
              if (ic->region)
                {
                   ic->region->list = eina_list_remove(ic->region->list, ic);
@@ -3806,9 +3857,9 @@ static void
 _e_fm2_queue_process(Evas_Object *obj)
 {
    E_Fm2_Smart_Data *sd;
-   E_Fm2_Icon *ic, *ic2;
-   Eina_List *l, **ll;
-   int added = 0, i, p0, p1, n, v;
+   E_Fm2_Icon *ic;
+   Eina_List *l;
+   unsigned int queued;
    double t;
    char buf[4096];
 
@@ -3819,110 +3870,42 @@ _e_fm2_queue_process(Evas_Object *obj)
         if (sd->resize_job) ecore_job_del(sd->resize_job);
         sd->resize_job = ecore_job_add(_e_fm2_cb_resize_job, obj);
         evas_object_smart_callback_call(sd->obj, "changed", NULL);
-        sd->tmp.last_insert = NULL;
         return;
      }
-//   double tt = ecore_time_get();
-//   int queued = eina_list_count(sd->queue);
-/* take unsorted and insert into the icon list - reprocess regions */
+/* take unsorted and merge into the icon list - reprocess regions */
    t = ecore_time_get();
-   if (!sd->tmp.last_insert)
+   queued = eina_list_count(sd->queue);
+   EINA_LIST_FOREACH(sd->queue, l, ic)
      {
-#if 1
-        n = eina_list_count(sd->icons);
-        E_FREE(sd->tmp.list_index);
-        if (n > 0)
-          sd->tmp.list_index = calloc(n, sizeof(Eina_List *));
-        if (sd->tmp.list_index)
-          {
-             ll = sd->tmp.list_index;
-             for (l = sd->icons; l; l = eina_list_next(l))
-               {
-                  *ll = l;
-                  ll++;
-               }
-             /* binary search first queue */
-             ic = eina_list_data_get(sd->queue);
-             p0 = 0; p1 = n;
-             i = (p0 + p1) / 2;
-             ll = sd->tmp.list_index;
-             if (ll[i])
-               do /* avoid garbage deref */
-                 {
-                    ic2 = eina_list_data_get(ll[i]);
-                    v = _e_fm2_cb_icon_sort(ic, ic2);
-                    if (v < 0) /* ic should go before ic2 */
-                      p1 = i;
-                    else /* ic should go at or after ic2 */
-                      p0 = i;
-                    i = (p0 + p1) / 2;
-                    l = ll[i];
-                 }
-               while ((p1 - p0) > 1);
-          }
-        else
-#endif
-        l = sd->icons;
+        if (!ic->queued) abort();
+        if (ic->inserted) abort();
+        ic->queued = EINA_FALSE;
+        ic->inserted = EINA_TRUE;
      }
-   else
-     l = sd->tmp.last_insert;
-   while (sd->queue)
-     {
-        ic = sd->queue->data;
-        sd->queue = eina_list_remove_list(sd->queue, sd->queue);
-        /* insertion sort - better than qsort for the way we are doing
-         * things - incrimentally scan and sort as we go as we now know
-         * that the queue files are in order, we speed up insertions to
-         * a worst case of O(n) where n is the # of files in the list
-         * so far
-         */
-        if (sd->order_file)
-          {
-             l = NULL;
-          }
-        else
-          {
-             EINA_LIST_FOREACH(l, l, ic2)
-               {
-                  if (_e_fm2_cb_icon_sort(ic, ic2) < 0)
-                    {
-                       if (!ic->queued) abort();
-                       if (ic->inserted) abort();
-                       ic->queued = EINA_FALSE;
-                       ic->inserted = EINA_TRUE;
-                       if (l == sd->icons)
-                         sd->icons = eina_list_prepend(sd->icons, ic);
-                       else
-                         sd->icons = eina_list_prepend_relative_list(sd->icons,
-                                                                     ic, l);
-                       sd->tmp.last_insert = l;
-                       break;
-                    }
-               }
-          }
-        if (!l)
-          {
-             if (!ic->queued) abort();
-             if (ic->inserted) abort();
-             ic->queued = EINA_FALSE;
-             ic->inserted = EINA_TRUE;
-             sd->icons = eina_list_append(sd->icons, ic);
-             sd->tmp.last_insert = eina_list_last(sd->icons);
-          }
-        sd->icons_place = eina_list_append(sd->icons_place, ic);
-        added++;
-        /* if we spent more than 1/20th of a second inserting - give up
-         * for now */
-        if ((_e_fm2_toomany_get(sd)) && (!sd->toomany))
-          {
-             sd->toomany = EINA_TRUE;
-             break;
-          }
-        if ((ecore_time_get() - t) > 0.01) break;
+   if (sd->order_file)
+     {
+        sd->icons_place = eina_list_merge(sd->icons_place,
+                                          eina_list_clone(sd->queue));
+        sd->icons = eina_list_merge(sd->icons, sd->queue);
      }
-//   printf("FM: SORT %1.3f (%i files) (%i queued, %i added) [%i iter]\n",
-//	  ecore_time_get() - tt, eina_list_count(sd->icons), queued,
-//	  added, sd->tmp.iter);
+   else
+     {
+        /* sort the whole queue once and merge it in a single walk over the
+         * icons - O(n + k log k) per batch instead of an insertion walk per
+         * queued icon. the merge only takes a new icon when it is strictly
+         * less, so it lands after existing icons that compare equal */
+        sd->queue = eina_list_sort(sd->queue, 0, _e_fm2_cb_icon_sort);
+        sd->icons_place = eina_list_merge(sd->icons_place,
+                                          eina_list_clone(sd->queue));
+        sd->icons = eina_list_sorted_merge(sd->queue, sd->icons,
+                                           _e_fm2_cb_icon_sort);
+     }
+   sd->queue = NULL;
+   _e_fm2_typebuf_index_clear(sd);
+   if ((_e_fm2_toomany_get(sd)) && (!sd->toomany))
+     sd->toomany = EINA_TRUE;
+   DBG("FM: SORT %1.3f (%u files) (%u queued)",
+       ecore_time_get() - t, eina_list_count(sd->icons), queued);
    sd->overlay_count = eina_list_count(sd->icons);
    snprintf(buf, sizeof(buf), P_("%u file", "%u files", sd->overlay_count), sd->overlay_count);
    edje_object_part_text_set(sd->overlay, "e.text.busy_label", buf);
@@ -4395,6 +4378,7 @@ _e_fm2_icons_free(Evas_Object *obj)
    sd = evas_object_smart_data_get(obj);
    if (!sd) return;
    _e_fm2_queue_free(obj);
+   _e_fm2_typebuf_index_clear(sd);
    /* free all icons */
    EINA_LIST_FREE(sd->icons, ic)
      {
@@ -4407,8 +4391,6 @@ _e_fm2_icons_free(Evas_Object *obj)
    sd->range_selected = NULL;
    eina_list_free(sd->icons_place);
    sd->icons_place = NULL;
-   sd->tmp.last_insert = NULL;
-   E_FREE(sd->tmp.list_index);
 }
 
 static void
@@ -4615,6 +4597,8 @@ _e_fm2_icon_new(E_Fm2_Smart_Data *sd, const char *file, E_Fm2_Finfo *finf)
 static void
 _e_fm2_icon_unfill(E_Fm2_Icon *ic)
 {
+   _e_fm2_icon_sort_key_clear(ic);
+   if (ic->inserted) _e_fm2_typebuf_index_clear(ic->sd);
    eina_stringshare_del(ic->info.mime);
    eina_stringshare_del(ic->info.label);
    eina_stringshare_del(ic->info.comment);
@@ -4664,7 +4648,7 @@ static const char *
 _mime_get(const char *path)
 {
    const char *mime = efreet_mime_special_type_get(path);
-   if (!mime) mime = efreet_mime_globs_type_get(path);
+   if (!mime) mime = e_fm_mime_filename_get(path);
    if (!mime) mime = efreet_mime_fallback_type_get(path);
    return mime;
 }
@@ -4896,6 +4880,7 @@ _e_fm2_icon_free(E_Fm2_Icon *ic)
    eina_stringshare_del(ic->info.link);
    eina_stringshare_del(ic->info.real_link);
    eina_stringshare_del(ic->info.category);
+   _e_fm2_icon_sort_key_clear(ic);
    memset(ic, 0xff, sizeof(*ic));
    free(ic);
 }
@@ -5901,6 +5886,260 @@ _e_fm_typebuf_timer_cb(void *data)
    return ECORE_CALLBACK_CANCEL;
 }
 
+static void
+_e_fm2_typebuf_index_clear(E_Fm2_Smart_Data *sd)
+{
+   E_Fm2_Typebuf_Index *idx = sd->typebuf.index;
+
+   if (!idx) return;
+   sd->typebuf.index = NULL;
+   if (idx->trigrams) eina_hash_free(idx->trigrams);
+   free(idx->keys);
+   free(idx->strings);
+   free(idx);
+}
+
+static int
+_e_fm2_typebuf_key_cmp(const void *data1, const void *data2)
+{
+   const E_Fm2_Typebuf_Key *k1 = data1, *k2 = data2;
+   int ret;
+
+   ret = strcmp(k1->key, k2->key);
+   if (ret) return ret;
+   return (k1->order > k2->order) - (k1->order < k2->order);
+}
+
+static int
+_e_fm2_typebuf_key_order_cmp(const void *data1, const void *data2)
+{
+   const E_Fm2_Typebuf_Key *k1 = *(const E_Fm2_Typebuf_Key **)data1;
+   const E_Fm2_Typebuf_Key *k2 = *(const E_Fm2_Typebuf_Key **)data2;
+
+   return (k1->order > k2->order) - (k1->order < k2->order);
+}
+
+static char *
+_e_fm2_typebuf_index_fold(char *d, const char *s)
+{
+   for (; *s; s++, d++)
+     *d = tolower((unsigned char)*s);
+   *d = 0;
+   return d + 1;
+}
+
+/* built on the first keystroke after the icon list changed - typing a
+ * name is then one binary search per keystroke */
+static E_Fm2_Typebuf_Index *
+_e_fm2_typebuf_index_get(E_Fm2_Smart_Data *sd)
+{
+   E_Fm2_Typebuf_Index *idx;
+   E_Fm2_Typebuf_Key *k;
+   E_Fm2_Icon *ic;
+   Eina_List *l;
+   size_t size = 0;
+   unsigned int n = 0, order = 0;
+   char *p;
+
+   if (sd->typebuf.index) return sd->typebuf.index;
+
+   EINA_LIST_FOREACH(sd->icons, l, ic)
+     {
+        size += strlen(ic->info.file) + 1;
+        n++;
+        if ((ic->info.label) && (strcmp(ic->info.label, ic->info.file)))
+          {
+             size += strlen(ic->info.label) + 1;
+             n++;
+          }
+     }
+
+   idx = E_NEW(E_Fm2_Typebuf_Index, 1);
+   if (!idx) return NULL;
+   idx->keys = malloc((n + 1) * sizeof(E_Fm2_Typebuf_Key));
+   idx->strings = malloc(size + 1);
+   if ((!idx->keys) || (!idx->strings))
+     {
+        free(idx->keys);
+        free(idx->strings);
+        free(idx);
+        return NULL;
+     }
+
+   p = idx->strings;
+   k = idx->keys;
+   EINA_LIST_FOREACH(sd->icons, l, ic)
+     {
+        k->key = p;
+        k->ic = ic;
+        k->order = order;
+        p = _e_fm2_typebuf_index_fold(p, ic->info.file);
+        k++;
+        if ((ic->info.label) && (strcmp(ic->info.label, ic->info.file)))
+          {
+             k->key = p;
+             k->ic = ic;
+             k->order = order;
+             p = _e_fm2_typebuf_index_fold(p, ic->info.label);
+             k++;
+          }
+        order++;
+     }
+   idx->count = n;
+   qsort(idx->keys, idx->count, sizeof(E_Fm2_Typebuf_Key), _e_fm2_typebuf_key_cmp);
+   sd->typebuf.index = idx;
+   return idx;
+}
+
+static void
+_e_fm2_typebuf_index_trigrams_build(E_Fm2_Typebuf_Index *idx)
+{
+   Eina_Inarray *posting;
+   unsigned int i, *last;
+   const char *s;
+   char tri[4];
+
+   idx->trigrams = eina_hash_string_superfast_new(EINA_FREE_CB(eina_inarray_free));
+   tri[3] = 0;
+   for (i = 0; i < idx->count; i++)
+     {
+        for (s = idx->keys[i].key; (s[0]) && (s[1]) && (s[2]); s++)
+          {
+             memcpy(tri, s, 3);
+             posting = eina_hash_find(idx->trigrams, tri);
+             if (!posting)
+               {
+                  posting = eina_inarray_new(sizeof(unsigned int), 8);
+                  eina_hash_add(idx->trigrams, tri, posting);
+               }
+             /* keys come in order, so a repeat can only be the last one */
+             last = eina_inarray_count(posting) ?
+               eina_inarray_nth(posting, eina_inarray_count(posting) - 1) : NULL;
+             if ((!last) || (*last != i))
+               eina_inarray_push(posting, &i);
+          }
+     }
+}
+
+/* the shortest trigram posting list over all literal runs of the glob,
+ * or NULL if there is no run of 3 or more plain characters in it */
+static Eina_Inarray *
+_e_fm2_typebuf_index_trigram_find(E_Fm2_Typebuf_Index *idx, const char *glob, Eina_Bool *none)
+{
+   Eina_Inarray *posting, *best = NULL;
+   const char *s, *run = NULL;
+   char tri[4];
+
+   *none = EINA_FALSE;
+   tri[3] = 0;
+   for (s = glob; ; s++)
+     {
+        if ((*s) && (!strchr("*?[\\", *s)))
+          {
+             if (!run) run = s;
+             if (s - run < 2) continue;
+             if (!idx->trigrams) _e_fm2_typebuf_index_trigrams_build(idx);
+             memcpy(tri, s - 2, 3);
+             posting = eina_hash_find(idx->trigrams, tri);
+             if (!posting)
+               {
+                  /* a literal no key contains - nothing can match */
+                  *none = EINA_TRUE;
+                  return NULL;
+               }
+             if ((!best) || (eina_inarray_count(posting) < eina_inarray_count(best)))
+               best = posting;
+             continue;
+          }
+        run = NULL;
+        if (!*s) break;
+        if ((*s == '\\') && (s[1])) s++;
+        else if (*s == '[')
+          {
+             while ((s[1]) && (s[1] != ']')) s++;
+             if (s[1]) s++;
+          }
+     }
+   return best;
+}
+
+static void
+_e_fm2_typebuf_key_check(Eina_Inarray *found, const char *pat, Eina_Bool prefix, E_Fm2_Typebuf_Key *k)
+{
+   if ((prefix) || (!fnmatch(pat, k->key, 0)))
+     eina_inarray_push(found, &k);
+}
+
+/* returns the icons whose label or file name matches glob, in view
+ * order - just the first one unless all is set */
+static Eina_List *
+_e_fm2_typebuf_index_find(E_Fm2_Smart_Data *sd, const char *glob, Eina_Bool all)
+{
+   E_Fm2_Typebuf_Index *idx;
+   E_Fm2_Typebuf_Key **k, *prev = NULL;
+   Eina_Inarray *found, *posting;
+   Eina_List *sel = NULL;
+   unsigned int i, lo, hi, mid, *pi;
+   Eina_Bool none, prefix;
+   const char *s;
+   char *pat;
+   size_t plen;
+
+   s = strrchr(glob, '/');
+   if (s) glob = s + 1;
+   idx = _e_fm2_typebuf_index_get(sd);
+   if ((!idx) || (!idx->count)) return NULL;
+
+   pat = alloca(strlen(glob) + 1);
+   _e_fm2_typebuf_index_fold(pat, glob);
+   plen = strcspn(pat, "*?[\\");
+   /* "literal*" - everything in the range matches, no need to check */
+   prefix = ((pat[plen] == '*') && (!pat[plen + 1]));
+
+   found = eina_inarray_new(sizeof(E_Fm2_Typebuf_Key *), 32);
+   if (!found) return NULL;
+
+   if (plen > 0)
+     {
+        /* literal prefix - all candidates are one range of the keys */
+        lo = 0;
+        hi = idx->count;
+        while (lo < hi)
+          {
+             mid = lo + ((hi - lo) / 2);
+             if (strncmp(idx->keys[mid].key, pat, plen) < 0) lo = mid + 1;
+             else hi = mid;
+          }
+        for (i = lo; i < idx->count; i++)
+          {
+             if (strncmp(idx->keys[i].key, pat, plen)) break;
+             _e_fm2_typebuf_key_check(found, pat, prefix, &(idx->keys[i]));
+          }
+     }
+   else if ((posting = _e_fm2_typebuf_index_trigram_find(idx, pat, &none)))
+     {
+        EINA_INARRAY_FOREACH(posting, pi)
+          _e_fm2_typebuf_key_check(found, pat, EINA_FALSE, &(idx->keys[*pi]));
+     }
+   else if (!none)
+     {
+        for (i = 0; i < idx->count; i++)
+          _e_fm2_typebuf_key_check(found, pat, prefix, &(idx->keys[i]));
+     }
+
+   eina_inarray_sort(found, _e_fm2_typebuf_key_order_cmp);
+   EINA_INARRAY_FOREACH(found, k)
+     {
+        /* label and file name of one icon may both match */
+        if ((prev) && (prev->ic == (*k)->ic)) continue;
+        prev = *k;
+        sel = eina_list_append(sel, prev->ic);
+        if (!all) break;
+     }
+   eina_inarray_free(found);
+   return sel;
+}
+
 static E_Fm2_Icon *
 _e_fm2_typebuf_match(Evas_Object *obj, int next)
 {
@@ -5932,14 +6171,7 @@ _e_fm2_typebuf_match(Evas_Object *obj, int next)
 
    if (!next)
      {
-        EINA_LIST_FOREACH(sd->icons, l, ic)
-          {
-             if (_e_fm2_typebuf_match_func(ic, tb))
-               {
-                  sel = eina_list_append(sel, ic);
-                  if (!sd->typebuf.wildcard) break;
-               }
-          }
+        sel = _e_fm2_typebuf_index_find(sd, tb, !!sd->typebuf.wildcard);
         if (eina_list_count(sel) == 1)
           ic_match = eina_list_data_get(sel);
      }
@@ -8374,19 +8606,46 @@ _e_fm2_cb_resize_job(void *data)
      }
 }
 
+static void
+_e_fm2_icon_sort_key_clear(E_Fm2_Icon *ic)
+{
+   E_FREE(ic->sort.label);
+   ic->sort.src = NULL;
+   ic->sort.ext = NULL;
+}
+
+static void
+_e_fm2_icon_sort_key_update(E_Fm2_Icon *ic)
+{
+   const char *l, *s;
+   char *d;
+
+   l = ic->info.file;
+   if (ic->info.label) l = ic->info.label;
+   if ((ic->sort.label) && (ic->sort.src == l)) return;
+   free(ic->sort.label);
+   ic->sort.src = l;
+   ic->sort.ext = strrchr(ecore_file_file_get(l), '.');
+   ic->sort.label = malloc(strlen(l) + 1);
+   if (!ic->sort.label) ic->sort.label = strdup("");
+   else
+     {
+        for (s = l, d = ic->sort.label; *s; s++, d++)
+          *d = tolower((unsigned char)*s);
+        *d = 0;
+     }
+}
+
 static int
 _e_fm2_cb_icon_sort(const void *data1, const void *data2)
 {
-   const E_Fm2_Icon *ic1, *ic2;
-   char *l1, *l2;
+   E_Fm2_Icon *ic1, *ic2;
+   const E_Fm2_Config *cfg;
 
-   ic1 = data1;
-   ic2 = data2;
-   l1 = (char *)ic1->info.file;
-   if (ic1->info.label) l1 = (char *)ic1->info.label;
-   l2 = (char *)ic2->info.file;
-   if (ic2->info.label) l2 = (char *)ic2->info.label;
-   if (ic1->sd->config->list.sort.dirs.first)
+   ic1 = (E_Fm2_Icon *)data1;
+   ic2 = (E_Fm2_Icon *)data2;
+   cfg = ic1->sd->config;
+   if (cfg->list.sort.dirs.first)
      {
         if ((S_ISDIR(ic1->info.statinfo.st_mode)) !=
             (S_ISDIR(ic2->info.statinfo.st_mode)))
@@ -8395,7 +8654,7 @@ _e_fm2_cb_icon_sort(const void *data1, const void *data2)
              return 1;
           }
      }
-   else if (ic1->sd->config->list.sort.dirs.last)
+   else if (cfg->list.sort.dirs.last)
      {
         if ((S_ISDIR(ic1->info.statinfo.st_mode)) !=
             (S_ISDIR(ic2->info.statinfo.st_mode)))
@@ -8404,21 +8663,22 @@ _e_fm2_cb_icon_sort(const void *data1, const void *data2)
              return -1;
           }
      }
-   if (ic1->sd->config->list.sort.mtime)
+   if (cfg->list.sort.mtime)
      {
         if (ic1->info.statinfo.st_mtime > ic2->info.statinfo.st_mtime)
           return -1;
         if (ic1->info.statinfo.st_mtime < ic2->info.statinfo.st_mtime)
           return 1;
      }
-   if (ic1->sd->config->list.sort.extension)
+   _e_fm2_icon_sort_key_update(ic1);
+   _e_fm2_icon_sort_key_update(ic2);
+   if (cfg->list.sort.extension)
      {
         int cmp;
         const char *f1, *f2;
-        f1 = ecore_file_file_get(l1);
-        f1 = strrchr(f1, '.');
-        f2 = ecore_file_file_get(l2);
-        f2 = strrchr(f2, '.');
+
+        f1 = ic1->sort.ext;
+        f2 = ic2->sort.ext;
         if (f1 && f2)
           {
              cmp = strcasecmp(f1, f2);
@@ -8429,7 +8689,7 @@ _e_fm2_cb_icon_sort(const void *data1, const void *data2)
         else if (f2)
           return -1;
      }
-   if (ic1->sd->config->list.sort.size)
+   if (cfg->list.sort.size)
      {
         if (ic1->info.link)
           {
@@ -8444,9 +8704,10 @@ _e_fm2_cb_icon_sort(const void *data1, const void *data2)
                return 1;
           }
      }
-   if (ic1->sd->config->list.sort.no_case)
-     return strcasecmp(l1, l2);
-   return strcmp(l1, l2);
+   /* the lowercased label compares exactly like strcasecmp() would */
+   if (cfg->list.sort.no_case)
+     return strcmp(ic1->sort.label, ic2->sort.label);
+   return strcmp(ic1->sort.src, ic2->sort.src);
 }
 
 static Eina_Bool
@@ -8686,6 +8947,7 @@ _e_fm2_smart_del(Evas_Object *obj)
    E_FREE(sd->typebuf.buf);
    if (sd->typebuf.timer) ecore_timer_del(sd->typebuf.timer);
    sd->typebuf.timer = NULL;
+   _e_fm2_typebuf_index_clear(sd);
    eina_list_free(sd->mount_ops);
 
    evas_object_del(sd->underlay);
@@ -10411,6 +10673,7 @@ _e_fm2_sort(void *data, E_Menu *m, E_Menu_Item *mi)
    sd = data;
    sd->icons = eina_list_sort(sd->icons, eina_list_count(sd->icons),
                               _e_fm2_cb_icon_sort);
+   _e_fm2_typebuf_index_clear(sd);
    _e_fm2_refresh(data, m, mi);
 }
 
@@ -11266,7 +11529,6 @@ _e_fm2_live_process_begin(Evas_Object *obj)
        (sd->listing) || (sd->scan_timer)) return;
    sd->live.idler = ecore_idler_add(_e_fm2_cb_live_idler, obj);
    sd->live.timer = ecore_timer_loop_add(0.2, _e_fm2_cb_live_timer, obj);
-   sd->tmp.last_insert = NULL;
 }
 
 static void
@@ -11294,7 +11556,6 @@ _e_fm2_live_process_end(Evas_Object *obj)
         ecore_timer_del(sd->live.timer);
         sd->live.timer = NULL;
      }
-   sd->tmp.last_insert = NULL;
 }
 
 static void
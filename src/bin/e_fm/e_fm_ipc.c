@@ -16,6 +16,7 @@
 #include <string.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <fcntl.h>
 #include <sys/time.h>
 #include <sys/param.h>
 #include <utime.h>
@@ -42,12 +43,16 @@
 #include "e_fm_main.h"
 #include "e_fm_shared_codec.h"
 #define DEF_MOD_BACKOFF          0.2
+/* listing batches are flushed to e when either limit is hit */
+#define LIST_BATCH_FILES         256
+#define LIST_BATCH_BYTES         (128 * 1024)
 
 typedef struct _E_Dir          E_Dir;
 typedef struct _E_Fop          E_Fop;
 typedef struct _E_Mod          E_Mod;
 typedef struct _e_fm_ipc_slave E_Fm_Slave;
 typedef struct _E_Fm_Task      E_Fm_Task;
+typedef struct _E_Fm_List_Batch E_Fm_List_Batch;
 
 struct _E_Dir
 {
@@ -107,6 +112,12 @@ struct _E_Fm_Task
    int          x, y;
 };
 
+struct _E_Fm_List_Batch
+{
+   Eina_Binbuf *buf;
+   int          count;
+};
+
 /* local subsystem globals */
 Ecore_Ipc_Server *_e_fm_ipc_server = NULL;
 
@@ -143,6 +154,7 @@ static int         _e_fm_ipc_slave_send(E_Fm_Slave *slave, E_Fm_Op_Type type, vo
 static void        _e_fm_ipc_cb_file_monitor(void *data, Ecore_File_Monitor *em, Ecore_File_Event event, const char *path);
 static Eina_Bool   _e_fm_ipc_cb_recent_clean(void *data);
 
+static Eina_Bool   _e_fm_ipc_file_info_append(Eina_Binbuf *buf, const char *path, int dfd, const char *name, Eina_File_Type type);
 static void        _e_fm_ipc_file_add_mod(E_Dir *ed, const char *path, E_Fm_Op_Type op, int listing);
 static void        _e_fm_ipc_file_add(E_Dir *ed, const char *path, int listing);
 static void        _e_fm_ipc_file_del(E_Dir *ed, const char *path);
@@ -231,59 +243,93 @@ static void
 _e_fm_ipc_cb_list_result(void *data, Ecore_Thread *thread EINA_UNUSED, void *msg_data)
 {
    E_Dir *ed = data;
-   Eina_List *files = msg_data;
-   const char *s;
+   E_Fm_List_Batch *lb = msg_data;
 
-   if (!files) _e_fm_ipc_file_add(ed, "", 2);
+   if (!lb) _e_fm_ipc_file_add(ed, "", 2);
    else
      {
-        EINA_LIST_FREE(files, s)
-          {
-             _e_fm_ipc_file_add(ed, s, 2);
-             eina_stringshare_del(s);
-          }
+        ecore_ipc_server_send(_e_fm_ipc_server, 6 /*E_IPC_DOMAIN_FM*/,
+                              E_FM_OP_FILE_ADD_BATCH, lb->count, ed->id, 2,
+                              eina_binbuf_string_get(lb->buf),
+                              eina_binbuf_length_get(lb->buf));
+        eina_binbuf_free(lb->buf);
+        free(lb);
      }
 }
 
+static E_Fm_List_Batch *
+_e_fm_ipc_list_batch_new(void)
+{
+   E_Fm_List_Batch *lb;
+
+   lb = calloc(1, sizeof(E_Fm_List_Batch));
+   if (!lb) return NULL;
+   lb->buf = eina_binbuf_new();
+   if (!lb->buf)
+     {
+        free(lb);
+        return NULL;
+     }
+   return lb;
+}
+
+static void
+_e_fm_ipc_list_batch_free(E_Fm_List_Batch *lb)
+{
+   if (!lb) return;
+   eina_binbuf_free(lb->buf);
+   free(lb);
+}
+
 static void
 _e_fm_ipc_cb_list(void *data, Ecore_Thread *thread)
 {
    E_Dir *ed = data;
-   Eina_List *files = NULL;
-   int i, total = 0;
+   E_Fm_List_Batch *lb;
+   int dfd, total = 0;
    Eina_File_Direct_Info *info;
    Eina_Iterator *it = ed->lister_iterator;
    char buf[4096];
-   const char *s;
 
+   /* stat everything here rather than on the main loop and hand e whole
+    * batches of entries - one message per file doesn't scale to huge dirs */
+   dfd = open(ed->dir, O_RDONLY | O_DIRECTORY);
+   lb = _e_fm_ipc_list_batch_new();
+   if (!lb) goto done;
    if (!strcmp(ed->dir, "/")) snprintf(buf, sizeof(buf), "/.order");
    else snprintf(buf, sizeof(buf), "%s/.order", ed->dir);
-   if (ecore_file_exists(buf))
+   if (_e_fm_ipc_file_info_append(lb->buf, buf, dfd, ".order", EINA_FILE_UNKNOWN))
      {
-        s = eina_stringshare_add(buf);
-        files = eina_list_append(files, s);
+        lb->count++;
+        total++;
      }
-   i = 0;
    EINA_ITERATOR_FOREACH(it, info)
      {
         if (!strcmp(info->path + info->name_start, ".order")) continue;
         if (ecore_thread_check(thread))
           {
-             EINA_LIST_FREE(files, s) eina_stringshare_del(s);
+             _e_fm_ipc_list_batch_free(lb);
+             lb = NULL;
              break;
           }
-        s = eina_stringshare_add(info->path);
-        files = eina_list_append(files, s);
+        if (!_e_fm_ipc_file_info_append(lb->buf, info->path, dfd,
+                                        info->path + info->name_start,
+                                        info->type))
+          continue;
+        lb->count++;
         total++;
-        i++;
-        if (i >= 16)
+        if ((lb->count >= LIST_BATCH_FILES) ||
+            (eina_binbuf_length_get(lb->buf) >= LIST_BATCH_BYTES))
           {
-             i = 0;
-             ecore_thread_feedback(thread, files);
-             files = NULL;
+             ecore_thread_feedback(thread, lb);
+             lb = _e_fm_ipc_list_batch_new();
+             if (!lb) break;
           }
      }
-   if (files) ecore_thread_feedback(thread, files);
+   if ((lb) && (lb->count > 0)) ecore_thread_feedback(thread, lb);
+   else _e_fm_ipc_list_batch_free(lb);
+done:
+   if (dfd >= 0) close(dfd);
    if (total == 0) ecore_thread_feedback(thread, NULL);
 }
 
@@ -1009,16 +1055,68 @@ _e_fm_ipc_cb_recent_clean(void *data)
    return ECORE_CALLBACK_CANCEL;
 }
 
-static void
-_e_fm_ipc_file_add_mod(E_Dir *ed, const char *path, E_Fm_Op_Type op, int listing)
+/* file add/change format is as follows:
+ *
+ * stat_info[stat size] + broken_link[1] + path[n]\0 + lnk[n]\0 + rlnk[n]\0
+ *
+ * batches are just these records back to back. if dfd/name/type are given
+ * and the entry is known not to be a link it is stat'ed relative to the
+ * open dir instead of resolving the whole path again */
+static Eina_Bool
+_e_fm_ipc_file_info_append(Eina_Binbuf *buf, const char *path, int dfd, const char *name, Eina_File_Type type)
 {
    struct stat st;
    char *lnk = NULL, *rlnk = NULL;
    int broken_lnk = 0;
+
+   memset(&st, 0, sizeof(struct stat));
+   if ((dfd >= 0) && (name) &&
+       (type != EINA_FILE_UNKNOWN) && (type != EINA_FILE_LNK))
+     {
+        if (fstatat(dfd, name, &st, 0) == -1) return EINA_FALSE;
+     }
+   else
+     {
+        lnk = ecore_file_readlink(path);
+        if (stat((lnk && lnk[0]) ? lnk : path, &st) == -1)
+          {
+             if ((path[0] == 0) || (lnk)) broken_lnk = 1;
+             else return EINA_FALSE;
+          }
+        if ((lnk) && (lnk[0] != '/'))
+          {
+             rlnk = ecore_file_realpath(path);
+             if ((rlnk == NULL) || (rlnk[0] == 0) ||
+                 (stat(rlnk, &st) == -1))
+               broken_lnk = 1;
+             else
+               broken_lnk = 0;
+          }
+        else if (lnk)
+          rlnk = strdup(lnk);
+     }
+
+   /* NOTE: i am NOT converting this data to portable arch/os independent
+    * format. i am ASSUMING e_fm_main and e are local and built together
+    * and thus this will work. if this ever changes this here needs to
+    * change */
+   eina_binbuf_append_length(buf, (void*)&st, sizeof(struct stat));
+
+   eina_binbuf_append_char(buf, !!broken_lnk);
+   eina_binbuf_append_length(buf, (void*)path, strlen(path) + 1);
+   if (lnk) eina_binbuf_append_length(buf, (void*)lnk, strlen(lnk) + 1);
+   else eina_binbuf_append_char(buf, 0);
+   if (rlnk) eina_binbuf_append_length(buf, (void*)rlnk, strlen(rlnk) + 1);
+   else eina_binbuf_append_char(buf, 0);
+   free(lnk);
+   free(rlnk);
+   return EINA_TRUE;
+}
+
+static void
+_e_fm_ipc_file_add_mod(E_Dir *ed, const char *path, E_Fm_Op_Type op, int listing)
+{
    Eina_Binbuf *buf;
-   /* file add/change format is as follows:
-    *
-    * stat_info[stat size] + broken_link[1] + path[n]\0 + lnk[n]\0 + rlnk[n]\0 */
 
    /* FIXME: handle BACKOFF */
    if ((!listing) && (op == E_FM_OP_FILE_CHANGE) && (!ed->cleaning)) /* 5 == mod */
@@ -1058,44 +1156,11 @@ _e_fm_ipc_file_add_mod(E_Dir *ed, const char *path, E_Fm_Op_Type op, int listing
           }
      }
 //   printf("MOD %s %3.3f\n", path, ecore_time_unix_get());
-   lnk = ecore_file_readlink(path);
-   memset(&st, 0, sizeof(struct stat));
-   if (stat((lnk && lnk[0]) ? lnk : path, &st) == -1)
-     {
-        if ((path[0] == 0) || (lnk)) broken_lnk = 1;
-        else return;
-     }
-   if ((lnk) && (lnk[0] != '/'))
-     {
-        rlnk = ecore_file_realpath(path);
-        if ((rlnk == NULL) || (rlnk[0] == 0) ||
-            (stat(rlnk, &st) == -1))
-          broken_lnk = 1;
-        else
-          broken_lnk = 0;
-     }
-   else if (lnk)
-     rlnk = strdup(lnk);
-   if (!lnk) lnk = strdup("");
-   if (!rlnk) rlnk = strdup("");
-
    buf = eina_binbuf_new();
-   /* NOTE: i am NOT converting this data to portable arch/os independent
-    * format. i am ASSUMING e_fm_main and e are local and built together
-    * and thus this will work. if this ever changes this here needs to
-    * change */
-   eina_binbuf_append_length(buf, (void*)&st, sizeof(struct stat));
-
-   eina_binbuf_append_char(buf, !!broken_lnk);
-   eina_binbuf_append_length(buf, (void*)path, strlen(path) + 1);
-   eina_binbuf_append_length(buf, (void*)lnk, strlen(lnk) + 1);
-   eina_binbuf_append_length(buf, (void*)rlnk, strlen(rlnk) + 1);
-
-   ecore_ipc_server_send(_e_fm_ipc_server, 6 /*E_IPC_DOMAIN_FM*/, op, 0, ed->id,
-                         listing, eina_binbuf_string_get(buf), eina_binbuf_length_get(buf));
+   if (_e_fm_ipc_file_info_append(buf, path, -1, NULL, EINA_FILE_UNKNOWN))
+     ecore_ipc_server_send(_e_fm_ipc_server, 6 /*E_IPC_DOMAIN_FM*/, op, 0, ed->id,
+                           listing, eina_binbuf_string_get(buf), eina_binbuf_length_get(buf));
    eina_binbuf_free(buf);
-   free(lnk);
-   free(rlnk);
 }
 
 static void
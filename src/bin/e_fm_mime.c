@@ -1,26 +1,77 @@
 #include "e.h"
 
-/* local types */
-typedef struct _E_Fm2_Mime_Handler_Tuple E_Fm2_Mime_Handler_Tuple;
-struct _E_Fm2_Mime_Handler_Tuple
-{
-   Eina_List  *list;
-   const char *str;
-};
-
 /* local subsystem functions */
-static Eina_Bool _e_fm2_mime_handler_glob_match_foreach(const Eina_Hash *hash EINA_UNUSED, const void *key, void *data, void *fdata);
+static Eina_Bool _e_fm2_mime_handler_glob_compile_foreach(const Eina_Hash *hash EINA_UNUSED, const void *key, void *data, void *fdata);
+static void _e_fm2_mime_handler_glob_compile(void);
+static void _e_fm2_mime_handler_glob_compiled_free(void);
 static Eina_Bool _e_fm_mime_icon_foreach(const Eina_Hash *hash EINA_UNUSED, const void *key EINA_UNUSED, void *data, void *fdata);
 
 static Eina_Hash *icon_map = NULL;
 static Eina_Hash *_mime_handlers = NULL;
 static Eina_Hash *_glob_handlers = NULL;
 
+/* globs of the "*literal" kind match exactly the names ending in that
+ * literal, so they are looked up by suffix - one hash lookup per distinct
+ * suffix length instead of one fnmatch() per glob. everything else is
+ * kept in a list and still matched one by one. rebuilt on first use after
+ * any glob handler was added or deleted. */
+static Eina_Hash *_glob_suffixes = NULL;
+static Eina_List *_glob_suffix_lens = NULL;
+static Eina_List *_glob_complex = NULL;
+static Eina_Bool _glob_dirty = EINA_FALSE;
+
+/* mime type by file extension - see e_fm_mime_filename_get() */
+static Eina_Hash *_ext_mime = NULL;
+static const char _ext_mime_uncached[] = "";
+
 /* externally accessible functions */
 E_API const char *
 e_fm_mime_filename_get(const char *fname)
 {
-   return efreet_mime_globs_type_get(fname);
+   const char *base, *ext, *mime, *probe_mime;
+   char *probe;
+   size_t len;
+
+   if (!fname) return NULL;
+   base = strrchr(fname, '/');
+   ext = strchr(base ? base + 1 : fname, '.');
+   if ((!ext) || (!ext[1])) return efreet_mime_globs_type_get(fname);
+
+   mime = eina_hash_find(_ext_mime, ext);
+   if (mime == _ext_mime_uncached) return efreet_mime_globs_type_get(fname);
+   if (mime) return mime;
+
+   /* efreet resolves "*.ext" globs from the extension alone and only then
+    * tries the other globs, so a type found for a name made of nothing
+    * but the extension holds for every name with that extension - unless
+    * the real name matched something else first, then never remember it */
+   mime = efreet_mime_globs_type_get(fname);
+   len = strlen(ext);
+   probe = alloca(len + 2);
+   probe[0] = '_';
+   memcpy(probe + 1, ext, len + 1);
+   probe_mime = efreet_mime_globs_type_get(probe);
+
+   if (eina_hash_population(_ext_mime) > 512) e_fm_mime_filename_cache_flush();
+   if (!_ext_mime) _ext_mime = eina_hash_string_superfast_new(NULL);
+   if ((mime) && (probe_mime) && (!strcmp(mime, probe_mime)))
+     eina_hash_add(_ext_mime, ext, eina_stringshare_add(mime));
+   else
+     eina_hash_add(_ext_mime, ext, _ext_mime_uncached);
+   return mime;
+}
+
+E_API void
+e_fm_mime_filename_cache_flush(void)
+{
+   Eina_List *freelist = NULL;
+   const char *mime;
+
+   eina_hash_foreach(_ext_mime, _e_fm_mime_icon_foreach, &freelist);
+   EINA_LIST_FREE(freelist, mime)
+     if (mime != _ext_mime_uncached) eina_stringshare_del(mime);
+   eina_hash_free(_ext_mime);
+   _ext_mime = NULL;
 }
 
 /* returns:
@@ -213,6 +264,7 @@ e_fm2_mime_handler_glob_add(E_Fm2_Mime_Handler *handler, const char *glob_)
         if (!_glob_handlers) _glob_handlers = eina_hash_string_superfast_new(NULL);
         eina_hash_add(_glob_handlers, glob_, handlers);
      }
+   _glob_dirty = EINA_TRUE;
 
    return 1;
 }
@@ -266,6 +318,7 @@ e_fm2_mime_handler_glob_del(E_Fm2_Mime_Handler *handler, const char *glob_)
                   _glob_handlers = NULL;
                }
           }
+        _glob_dirty = EINA_TRUE;
      }
 }
 
@@ -281,17 +334,36 @@ e_fm2_mime_handler_mime_handlers_get(const char *mime)
 E_API Eina_List *
 e_fm2_mime_handler_glob_handlers_get(const char *glob_)
 {
-   E_Fm2_Mime_Handler_Tuple *tuple = NULL;
-   Eina_List *handlers = NULL;
+   Eina_List *handlers = NULL, *matched, *l, *ll;
+   const char *key;
+   void *handler, *lenp;
+   size_t len;
 
    if ((!glob_) || (!_glob_handlers)) return NULL;
 
-   tuple = E_NEW(E_Fm2_Mime_Handler_Tuple, 1);
-   tuple->list = NULL;
-   tuple->str = glob_;
-   eina_hash_foreach(_glob_handlers, _e_fm2_mime_handler_glob_match_foreach, tuple);
-   handlers = tuple->list;
-   E_FREE(tuple);
+   if (_glob_dirty) _e_fm2_mime_handler_glob_compile();
+
+   len = strlen(glob_);
+   EINA_LIST_FOREACH(_glob_suffix_lens, l, lenp)
+     {
+        if ((size_t)(uintptr_t)lenp > len) break;
+        matched = eina_hash_find(_glob_suffixes, glob_ + len - (uintptr_t)lenp);
+        EINA_LIST_FOREACH(matched, ll, handler)
+          {
+             if (handler)
+               handlers = eina_list_append(handlers, handler);
+          }
+     }
+   EINA_LIST_FOREACH(_glob_complex, l, key)
+     {
+        if (!e_util_glob_match(glob_, key)) continue;
+        matched = eina_hash_find(_glob_handlers, key);
+        EINA_LIST_FOREACH(matched, ll, handler)
+          {
+             if (handler)
+               handlers = eina_list_append(handlers, handler);
+          }
+     }
    return handlers;
 }
 
@@ -369,29 +441,53 @@ e_fm2_mime_handler_test(E_Fm2_Mime_Handler *handler, Evas_Object *obj, const cha
 }
 
 /* local subsystem functions */
-/* used to loop a glob hash and determine if the glob handler matches the filename */
+static int
+_e_fm2_mime_handler_glob_len_cmp(const void *data1, const void *data2)
+{
+   return (int)((intptr_t)data1 - (intptr_t)data2);
+}
+
+/* sort every registered glob into the suffix hash or the complex list */
 static Eina_Bool
-_e_fm2_mime_handler_glob_match_foreach(const Eina_Hash *hash EINA_UNUSED, const void *key, void *data, void *fdata)
+_e_fm2_mime_handler_glob_compile_foreach(const Eina_Hash *hash EINA_UNUSED, const void *key, void *data, void *fdata EINA_UNUSED)
 {
-   E_Fm2_Mime_Handler_Tuple *tuple;
-   Eina_List *handlers = NULL;
-   Eina_List *l = NULL;
-   void *handler = NULL;
+   const char *glob_ = key;
+   size_t len;
 
-   tuple = fdata;
-   if (e_util_glob_match(tuple->str, key))
+   if ((glob_[0] == '*') && (glob_[1]) && (!strpbrk(glob_ + 1, "*?[\\")))
      {
-        handlers = data;
-        EINA_LIST_FOREACH(handlers, l, handler)
-          {
-             if (handler)
-               tuple->list = eina_list_append(tuple->list, handler);
-          }
+        eina_hash_add(_glob_suffixes, glob_ + 1, data);
+        len = strlen(glob_ + 1);
+        if (!eina_list_data_find(_glob_suffix_lens, (void *)(uintptr_t)len))
+          _glob_suffix_lens = eina_list_sorted_insert(_glob_suffix_lens,
+                                                      _e_fm2_mime_handler_glob_len_cmp,
+                                                      (void *)(uintptr_t)len);
      }
+   else
+     _glob_complex = eina_list_append(_glob_complex, glob_);
 
    return 1;
 }
 
+static void
+_e_fm2_mime_handler_glob_compile(void)
+{
+   _e_fm2_mime_handler_glob_compiled_free();
+   _glob_dirty = EINA_FALSE;
+   if (!_glob_handlers) return;
+
+   _glob_suffixes = eina_hash_string_superfast_new(NULL);
+   eina_hash_foreach(_glob_handlers, _e_fm2_mime_handler_glob_compile_foreach, NULL);
+}
+
+static void
+_e_fm2_mime_handler_glob_compiled_free(void)
+{
+   E_FREE_FUNC(_glob_suffixes, eina_hash_free);
+   _glob_suffix_lens = eina_list_free(_glob_suffix_lens);
+   _glob_complex = eina_list_free(_glob_complex);
+}
+
 static Eina_Bool
 _e_fm_mime_icon_foreach(const Eina_Hash *hash EINA_UNUSED, const void *key EINA_UNUSED, void *data, void *fdata)
 {
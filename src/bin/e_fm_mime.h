@@ -16,6 +16,7 @@ struct _E_Fm2_Mime_Handler
 };
 
 E_API const char *e_fm_mime_filename_get(const char *fname);
+E_API void e_fm_mime_filename_cache_flush(void);
 E_API const char *e_fm_mime_icon_get(const char *mime);
 E_API void e_fm_mime_icon_cache_flush(void);
 
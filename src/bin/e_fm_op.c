@@ -33,6 +33,10 @@ void *alloca(size_t);
 #include <errno.h>
 #include <limits.h>
 #include <fcntl.h>
+#include <dirent.h>
+#ifdef HAVE_SYS_SENDFILE_H
+# include <sys/sendfile.h>
+#endif
 
 #include <Ecore.h>
 #include <Ecore_File.h>
@@ -45,8 +49,11 @@ void *alloca(size_t);
 #include "e_fm_op.h"
 
 #define READBUFSIZE     65536
-#define COPYBUFSIZE     16384
+#define COPYBUFSIZE     (1024 * 1024)
+#define COPYCHUNKSIZE   (8 * 1024 * 1024)
+#define COPYSMALLSIZE   (256 * 1024)
 #define REMOVECHUNKSIZE 4096
+#define SCANBATCHSIZE   256
 #define NB_PASS         3
 
 #define E_FREE(p) do { free(p); p = NULL; } while (0)
@@ -73,6 +80,8 @@ void *alloca(size_t);
 
 typedef struct _E_Fm_Op_Task      E_Fm_Op_Task;
 typedef struct _E_Fm_Op_Copy_Data E_Fm_Op_Copy_Data;
+typedef struct _E_Fm_Op_Scan_Dir  E_Fm_Op_Scan_Dir;
+typedef struct _E_Fm_Op_Scan_Entry E_Fm_Op_Scan_Entry;
 
 static E_Fm_Op_Task *_e_fm_op_task_new(void);
 static void          _e_fm_op_task_free(void *t);
@@ -98,9 +107,14 @@ static int           _e_fm_op_copy_link(E_Fm_Op_Task *task);
 static int           _e_fm_op_copy_fifo(E_Fm_Op_Task *task);
 static int           _e_fm_op_open_files(E_Fm_Op_Task *task);
 static int           _e_fm_op_copy_chunk(E_Fm_Op_Task *task);
+static ssize_t       _e_fm_op_copy_data(E_Fm_Op_Copy_Data *data, size_t len, char *buf, size_t buf_size);
+static void          _e_fm_op_copy_dispatch(Eina_List *node);
 
 static int           _e_fm_op_copy_atom(E_Fm_Op_Task *task);
 static int           _e_fm_op_scan_atom(E_Fm_Op_Task *task);
+static void          _e_fm_op_scan_dir_queue(E_Fm_Op_Task *task);
+static void          _e_fm_op_scan_dir_pump(void);
+static void          _e_fm_op_scan_dir_free(E_Fm_Op_Scan_Dir *sd);
 static int           _e_fm_op_copy_stat_info_atom(E_Fm_Op_Task *task);
 static int           _e_fm_op_symlink_atom(E_Fm_Op_Task *task);
 static int           _e_fm_op_remove_atom(E_Fm_Op_Task *task);
@@ -116,6 +130,7 @@ Ecore_Idler *_e_fm_op_work_idler_p = NULL, *_e_fm_op_scan_idler_p = NULL;
 
 int _e_fm_op_abort = 0; /* Abort mark. */
 int _e_fm_op_scan_error = 0;
+int _e_fm_op_scan_waiting = 0; /* Scan idler sleeps until a listing is read. */
 int _e_fm_op_work_error = 0;
 int _e_fm_op_overwrite = 0;
 
@@ -126,6 +141,13 @@ Eina_List *_e_fm_op_separator = NULL;
 
 char *_e_fm_op_stdin_buffer = NULL;
 
+static char *_e_fm_op_copy_buf = NULL;
+static int _e_fm_op_copiers = 0;
+static int _e_fm_op_threads_max = 1;
+
+static Eina_List *_e_fm_op_scan_pending = NULL;
+static int _e_fm_op_scanners = 0;
+
 struct _E_Fm_Op_Task
 {
    struct
@@ -151,12 +173,48 @@ struct _E_Fm_Op_Task
    E_Fm_Op_Type  overwrite;
 
    Eina_List    *link;
+
+   Ecore_Thread *copier;
+   int           copier_failed;
+   int           orphan;
+
+   E_Fm_Op_Scan_Dir *scan;
+   int           stated;
+};
+
+/* A directory listing read ahead of the scan idler by a worker thread,
+ * together with the lstat() of every entry. */
+struct _E_Fm_Op_Scan_Dir
+{
+   E_Fm_Op_Task *task;
+   const char   *path;
+   Ecore_Thread *thread;
+   Eina_Inarray *entries;
+   unsigned int  pos;
+   int           err;
+   int           done;
+};
+
+struct _E_Fm_Op_Scan_Entry
+{
+   char       *name;
+   struct stat st;
+   int         err;
 };
 
+typedef enum
+{
+   COPY_METHOD_RANGE,
+   COPY_METHOD_SENDFILE,
+   COPY_METHOD_RW
+} E_Fm_Op_Copy_Method;
+
 struct _E_Fm_Op_Copy_Data
 {
-   FILE *from;
-   FILE *to;
+   int                 from;
+   int                 to;
+   E_Fm_Op_Copy_Method method;
+   off_t               copied;
 };
 
 int
@@ -171,6 +229,10 @@ main(int argc, char **argv)
    _e_fm_op_stdin_buffer = malloc(READBUFSIZE);
    if (!_e_fm_op_stdin_buffer) return 0;
 
+   _e_fm_op_threads_max = eina_cpu_count();
+   if (_e_fm_op_threads_max < 1) _e_fm_op_threads_max = 1;
+   else if (_e_fm_op_threads_max > 8) _e_fm_op_threads_max = 8;
+
    ecore_main_fd_handler_add(STDIN_FILENO, ECORE_FD_READ, _e_fm_op_stdin_data,
                              NULL, NULL, NULL);
 
@@ -428,6 +490,7 @@ quit:
    ecore_shutdown();
 
    E_FREE(_e_fm_op_stdin_buffer);
+   free(_e_fm_op_copy_buf);
 
    E_FM_OP_DEBUG("Slave quit.\n");
 
@@ -453,6 +516,11 @@ _e_fm_op_task_new()
    t->overwrite = E_FM_OP_NONE;
    t->link = NULL;
    t->pos = t->passes = 0;
+   t->copier = NULL;
+   t->copier_failed = 0;
+   t->orphan = 0;
+   t->scan = NULL;
+   t->stated = 0;
 
    return t;
 }
@@ -469,13 +537,26 @@ _e_fm_op_task_free(void *t)
    if (task->src.name) eina_stringshare_del(task->src.name);
    if (task->dst.name) eina_stringshare_del(task->dst.name);
 
+   if (task->scan)
+     {
+        task->scan->task = NULL;
+        if (task->scan->thread)
+          ecore_thread_cancel(task->scan->thread);
+        else
+          {
+             if (!task->scan->done)
+               _e_fm_op_scan_pending = eina_list_remove(_e_fm_op_scan_pending, task->scan);
+             _e_fm_op_scan_dir_free(task->scan);
+          }
+     }
+
    if (task->data)
      {
         data = task->data;
         if (task->type == E_FM_OP_COPY)
           {
-             if (data->from) fclose(data->from);
-             if (data->to) fclose(data->to);
+             if (data->from >= 0) close(data->from);
+             if (data->to >= 0) close(data->to);
           }
         E_FREE(task->data);
      }
@@ -753,7 +834,7 @@ _e_fm_op_work_idler(void *data EINA_UNUSED)
      {
         if ((_e_fm_op_separator) &&
             (_e_fm_op_work_queue == _e_fm_op_separator) &&
-            (!_e_fm_op_scan_idler_p))
+            (!_e_fm_op_scan_idler_p) && (!_e_fm_op_scan_waiting))
           {
              /* You may want to look at the comment in _e_fm_op_scan_atom() about this separator thing. */
              _e_fm_op_work_queue = eina_list_remove_list(_e_fm_op_work_queue, _e_fm_op_separator);
@@ -761,7 +842,8 @@ _e_fm_op_work_idler(void *data EINA_UNUSED)
              return ECORE_CALLBACK_RENEW;
           }
 
-        if ((!_e_fm_op_scan_idler_p) && (!_e_fm_op_work_error) &&
+        if ((!_e_fm_op_scan_idler_p) && (!_e_fm_op_scan_waiting) &&
+            (!_e_fm_op_work_error) &&
             (!_e_fm_op_scan_error))
           ecore_main_loop_quit();
         // if
@@ -779,6 +861,15 @@ _e_fm_op_work_idler(void *data EINA_UNUSED)
    if (_e_fm_op_idler_handle_error(&_e_fm_op_work_error, &_e_fm_op_work_queue, &node, task))
      return ECORE_CALLBACK_RENEW;
 
+   if ((task->type == E_FM_OP_COPY) && (!task->started) && (!_e_fm_op_abort))
+     _e_fm_op_copy_dispatch(node);
+   if (task->copier)
+     {
+        /* sleep until the copier is done - its end callback wakes us */
+        _e_fm_op_work_idler_p = NULL;
+        return ECORE_CALLBACK_CANCEL;
+     }
+
    task->started = 1;
 
    if (task->type == E_FM_OP_COPY)
@@ -814,6 +905,12 @@ _e_fm_op_work_idler(void *data EINA_UNUSED)
 /* This works pretty much the same as _e_fm_op_work_idler(), except that
  * if this is a dir, then look into its contents and create a task
  * for those files. And we don't have _e_fm_op_separator here.
+ *
+ * Directories are not read here but by worker threads a little ahead of
+ * the idler (see _e_fm_op_scan_dir_queue()), which also lstat() every
+ * entry, so the idler only turns ready listings into tasks - a batch of
+ * them per call. If the listing it needs is not ready yet, it sleeps and
+ * the thread wakes it up again.
  */
 Eina_Bool
 _e_fm_op_scan_idler(void *data EINA_UNUSED)
@@ -821,8 +918,10 @@ _e_fm_op_scan_idler(void *data EINA_UNUSED)
    static Eina_List *node = NULL;
    E_Fm_Op_Task *task = NULL;
    char buf[PATH_MAX];
-   static Eina_Iterator *dir = NULL;
    E_Fm_Op_Task *ntask = NULL;
+   E_Fm_Op_Scan_Dir *sd;
+   E_Fm_Op_Scan_Entry *ent;
+   int n;
 
    if (!node) node = _e_fm_op_scan_queue;
    task = eina_list_data_get(node);
@@ -859,20 +958,23 @@ _e_fm_op_scan_idler(void *data EINA_UNUSED)
              node = NULL;
           }
      }
-   else if (!dir && !task->started)
+   else if (!task->scan && !task->started)
      {
-        if (lstat(task->src.name, &(task->src.st)) < 0)
-          _E_FM_OP_ERROR_SEND_SCAN(task, E_FM_OP_ERROR,
-                                   "Cannot lstat '%s': %s.", task->src.name);
+        if (!task->stated)
+          {
+             if (lstat(task->src.name, &(task->src.st)) < 0)
+               _E_FM_OP_ERROR_SEND_SCAN(task, E_FM_OP_ERROR,
+                                        "Cannot lstat '%s': %s.", task->src.name);
+             task->stated = 1;
+          }
 
         if ((task->type != E_FM_OP_SYMLINK) &&
             (task->type != E_FM_OP_RENAME) &&
             S_ISDIR(task->src.st.st_mode))
           {
              /* If it's a dir, then look through it and add a task for each. */
-
-             dir = eina_file_direct_ls(task->src.name);
-             if (!dir)
+             _e_fm_op_scan_dir_queue(task);
+             if (!task->scan)
                _E_FM_OP_ERROR_SEND_SCAN(task, E_FM_OP_ERROR,
                                         "Cannot open directory '%s': %s.",
                                         task->dst.name);
@@ -886,54 +988,99 @@ _e_fm_op_scan_idler(void *data EINA_UNUSED)
              _e_fm_op_scan_atom(task);
           }
      }
-   else if (dir && !task->started)
+   else if (task->scan && !task->started)
      {
-        Eina_File_Direct_Info *info;
+        sd = task->scan;
+        if (!sd->done)
+          {
+             /* Jump the queue - this is the one we are waiting for. */
+             if (!sd->thread)
+               {
+                  _e_fm_op_scan_pending = eina_list_remove(_e_fm_op_scan_pending, sd);
+                  _e_fm_op_scan_pending = eina_list_prepend(_e_fm_op_scan_pending, sd);
+                  _e_fm_op_scan_dir_pump();
+               }
+             if (!sd->done)
+               {
+                  _e_fm_op_scan_waiting = 1;
+                  _e_fm_op_scan_idler_p = NULL;
+                  return ECORE_CALLBACK_CANCEL;
+               }
+          }
+        if (sd->err)
+          {
+             int err = sd->err;
+
+             /* drop the failed listing, so a retry reads the directory
+              * again instead of reporting the same error */
+             task->scan = NULL;
+             _e_fm_op_scan_dir_free(sd);
+             errno = err;
+             _E_FM_OP_ERROR_SEND_SCAN(task, E_FM_OP_ERROR,
+                                      "Cannot open directory '%s': %s.",
+                                      task->dst.name);
+          }
 
-        if (!eina_iterator_next(dir, (void **)&info))
+        for (n = 0; n < SCANBATCHSIZE; n++)
           {
+             if (sd->pos >= eina_inarray_count(sd->entries))
+               {
+                  ntask = _e_fm_op_task_new();
+                  ntask->type = E_FM_OP_COPY_STAT_INFO;
+                  ntask->parent = task;
+                  ntask->src.name = eina_stringshare_add(task->src.name);
+                  memcpy(&(ntask->src.st), &(task->src.st), sizeof(struct stat));
+
+                  if (task->dst.name)
+                    ntask->dst.name = eina_stringshare_add(task->dst.name);
+                  else
+                    ntask->dst.name = NULL;
+
+                  if (task->type == E_FM_OP_REMOVE)
+                    _e_fm_op_scan_queue =
+                      eina_list_prepend(_e_fm_op_scan_queue, ntask);
+                  else
+                    _e_fm_op_scan_queue =
+                      eina_list_append(_e_fm_op_scan_queue, ntask);
+
+                  task->started = 1;
+                  task->scan = NULL;
+                  _e_fm_op_scan_dir_free(sd);
+                  node = NULL;
+                  return ECORE_CALLBACK_RENEW;
+               }
+
+             ent = eina_inarray_nth(sd->entries, sd->pos++);
+
              ntask = _e_fm_op_task_new();
-             ntask->type = E_FM_OP_COPY_STAT_INFO;
+             ntask->type = task->type;
+             snprintf(buf, sizeof(buf), "%s/%s", task->src.name, ent->name);
+             ntask->src.name = eina_stringshare_add(buf);
              ntask->parent = task;
-             ntask->src.name = eina_stringshare_add(task->src.name);
-             memcpy(&(ntask->src.st), &(task->src.st), sizeof(struct stat));
+             /* entries the thread could not lstat() get another go (and
+              * their error reported) when the idler reaches them */
+             if (!ent->err)
+               {
+                  memcpy(&(ntask->src.st), &(ent->st), sizeof(struct stat));
+                  ntask->stated = 1;
+               }
 
              if (task->dst.name)
-               ntask->dst.name = eina_stringshare_add(task->dst.name);
+               {
+                  snprintf(buf, sizeof(buf), "%s/%s", task->dst.name, ent->name);
+                  ntask->dst.name = eina_stringshare_add(buf);
+               }
              else
                ntask->dst.name = NULL;
 
              if (task->type == E_FM_OP_REMOVE)
-               _e_fm_op_scan_queue =
-                 eina_list_prepend(_e_fm_op_scan_queue, ntask);
+               _e_fm_op_scan_queue = eina_list_prepend(_e_fm_op_scan_queue, ntask);
              else
-               _e_fm_op_scan_queue =
-                 eina_list_append(_e_fm_op_scan_queue, ntask);
-
-             task->started = 1;
-             eina_iterator_free(dir);
-             dir = NULL;
-             node = NULL;
-             return ECORE_CALLBACK_RENEW;
-          }
+               _e_fm_op_scan_queue = eina_list_append(_e_fm_op_scan_queue, ntask);
 
-        ntask = _e_fm_op_task_new();
-        ntask->type = task->type;
-        ntask->src.name = eina_stringshare_add(info->path);
-        ntask->parent = task;
-
-        if (task->dst.name)
-          {
-             snprintf(buf, sizeof(buf), "%s/%s", task->dst.name, info->path + info->name_start);
-             ntask->dst.name = eina_stringshare_add(buf);
+             if ((ntask->stated) && (S_ISDIR(ntask->src.st.st_mode)))
+               _e_fm_op_scan_dir_queue(ntask);
           }
-        else
-          ntask->dst.name = NULL;
-
-        if (task->type == E_FM_OP_REMOVE)
-          _e_fm_op_scan_queue = eina_list_prepend(_e_fm_op_scan_queue, ntask);
-        else
-          _e_fm_op_scan_queue = eina_list_append(_e_fm_op_scan_queue, ntask);
      }
    else
      {
@@ -950,6 +1097,141 @@ _e_fm_op_scan_idler(void *data EINA_UNUSED)
    return ECORE_CALLBACK_RENEW;
 }
 
+static void
+_e_fm_op_scan_dir_free(E_Fm_Op_Scan_Dir *sd)
+{
+   E_Fm_Op_Scan_Entry *ent;
+
+   EINA_INARRAY_FOREACH(sd->entries, ent)
+     free(ent->name);
+   eina_inarray_free(sd->entries);
+   eina_stringshare_del(sd->path);
+   free(sd);
+}
+
+/* Runs in a thread. Reads the whole directory and lstat()s the entries
+ * relative to the directory fd, so no path is resolved twice. */
+static void
+_e_fm_op_scan_dir_thread(void *data, Ecore_Thread *thread)
+{
+   E_Fm_Op_Scan_Dir *sd = data;
+   E_Fm_Op_Scan_Entry ent;
+   struct dirent *de;
+   DIR *dir;
+   int fd;
+
+   fd = open(sd->path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   if (fd < 0)
+     {
+        sd->err = errno;
+        return;
+     }
+   dir = fdopendir(fd);
+   if (!dir)
+     {
+        sd->err = errno;
+        close(fd);
+        return;
+     }
+   while ((de = readdir(dir)))
+     {
+        if (ecore_thread_check(thread)) break;
+        if ((de->d_name[0] == '.') &&
+            ((!de->d_name[1]) ||
+             ((de->d_name[1] == '.') && (!de->d_name[2]))))
+          continue;
+
+        ent.name = strdup(de->d_name);
+        if (!ent.name) continue;
+        ent.err = 0;
+        if (fstatat(fd, de->d_name, &(ent.st), AT_SYMLINK_NOFOLLOW) < 0)
+          ent.err = errno;
+        if (eina_inarray_push(sd->entries, &ent) < 0)
+          free(ent.name);
+     }
+   closedir(dir);
+}
+
+static void
+_e_fm_op_scan_dir_thread_end(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   E_Fm_Op_Scan_Dir *sd = data;
+
+   sd->thread = NULL;
+   sd->done = 1;
+   _e_fm_op_scanners--;
+   if (!sd->task) _e_fm_op_scan_dir_free(sd);
+
+   _e_fm_op_scan_dir_pump();
+   if (_e_fm_op_scan_waiting)
+     {
+        _e_fm_op_scan_waiting = 0;
+        if (!_e_fm_op_scan_idler_p)
+          _e_fm_op_scan_idler_p = ecore_idler_add(_e_fm_op_scan_idler, NULL);
+     }
+}
+
+static void
+_e_fm_op_scan_dir_thread_cancel(void *data, Ecore_Thread *thread)
+{
+   E_Fm_Op_Scan_Dir *sd = data;
+
+   if (!sd->err) sd->err = ECANCELED;
+   _e_fm_op_scan_dir_thread_end(sd, thread);
+}
+
+/* Starts reading listings of queued directories while there are free
+ * worker slots. */
+static void
+_e_fm_op_scan_dir_pump(void)
+{
+   E_Fm_Op_Scan_Dir *sd;
+   Ecore_Thread *th;
+
+   while ((_e_fm_op_scan_pending) &&
+          (_e_fm_op_scanners < _e_fm_op_threads_max))
+     {
+        sd = eina_list_data_get(_e_fm_op_scan_pending);
+        _e_fm_op_scan_pending =
+          eina_list_remove_list(_e_fm_op_scan_pending, _e_fm_op_scan_pending);
+        _e_fm_op_scanners++;
+        th = ecore_thread_run(_e_fm_op_scan_dir_thread,
+                              _e_fm_op_scan_dir_thread_end,
+                              _e_fm_op_scan_dir_thread_cancel, sd);
+        /* if ecore could not start it, the cancel cb already ran */
+        if (!th) break;
+        sd->thread = th;
+     }
+}
+
+/* Queues reading the listing of a directory task. Subdirectories are
+ * queued as soon as their parent listing is turned into tasks, so whole
+ * levels of a tree are read in parallel long before the idler gets to
+ * them, and their tasks (and the progress totals) come in quickly. */
+static void
+_e_fm_op_scan_dir_queue(E_Fm_Op_Task *task)
+{
+   E_Fm_Op_Scan_Dir *sd;
+
+   if (task->scan) return;
+   if ((task->type == E_FM_OP_SYMLINK) || (task->type == E_FM_OP_RENAME))
+     return;
+
+   sd = calloc(1, sizeof(E_Fm_Op_Scan_Dir));
+   if (!sd) return;
+   sd->entries = eina_inarray_new(sizeof(E_Fm_Op_Scan_Entry), 64);
+   if (!sd->entries)
+     {
+        free(sd);
+        return;
+     }
+   sd->task = task;
+   sd->path = eina_stringshare_ref(task->src.name);
+   task->scan = sd;
+   _e_fm_op_scan_pending = eina_list_append(_e_fm_op_scan_pending, sd);
+   _e_fm_op_scan_dir_pump();
+}
+
 /* Packs and sends an error to STDOUT.
  * type is either E_FM_OP_ERROR or E_FM_OP_OVERWRITE.
  * fmt is a printf format string, the other arguments
@@ -1013,7 +1295,9 @@ _e_fm_op_rollback(E_Fm_Op_Task *task)
         if (t == task) continue;
         if (t->parent != task) continue;
         _e_fm_op_work_queue = eina_list_remove_list(_e_fm_op_work_queue, l);
-        _e_fm_op_task_free(t);
+        /* a copier thread still owns it - let it clean up when it ends */
+        if (t->copier) t->orphan = 1;
+        else _e_fm_op_task_free(t);
      }
 
    if (task->type == E_FM_OP_COPY)
@@ -1021,15 +1305,15 @@ _e_fm_op_rollback(E_Fm_Op_Task *task)
         data = task->data;
         if (data)
           {
-             if (data->from)
+             if (data->from >= 0)
                {
-                  fclose(data->from);
-                  data->from = NULL;
+                  close(data->from);
+                  data->from = -1;
                }
-             if (data->to)
+             if (data->to >= 0)
                {
-                  fclose(data->to);
-                  data->to = NULL;
+                  close(data->to);
+                  data->to = -1;
                }
           }
         E_FREE(task->data);
@@ -1121,7 +1405,7 @@ _e_fm_op_update_progress(E_Fm_Op_Task *task, off_t _plus_e_fm_op_done, off_t _pl
    _e_fm_op_total += _plus_e_fm_op_total;
 
    /* Do not send progress until scan is done.*/
-   if (_e_fm_op_scan_idler_p) return;
+   if ((_e_fm_op_scan_idler_p) || (_e_fm_op_scan_waiting)) return;
 
    if (_e_fm_op_total != 0)
      {
@@ -1363,21 +1647,26 @@ _e_fm_op_open_files(E_Fm_Op_Task *task)
      {
         data = malloc(sizeof(E_Fm_Op_Copy_Data));
         task->data = data;
-        data->to = NULL;
-        data->from = NULL;
+        data->to = -1;
+        data->from = -1;
+        data->method = COPY_METHOD_RANGE;
+        data->copied = 0;
      }
 
-   if (!data->from)
+   if (data->from < 0)
      {
-        data->from = fopen(task->src.name, "rb");
-        if (!data->from)
+        data->from = open(task->src.name, O_RDONLY | O_CLOEXEC);
+        if (data->from < 0)
           _E_FM_OP_ERROR_SEND_WORK(task, E_FM_OP_ERROR, "Cannot open file '%s' for reading: %s.", task->src.name);
+#ifdef HAVE_POSIX_FADVISE
+        posix_fadvise(data->from, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
      }
 
-   if (!data->to)
+   if (data->to < 0)
      {
-        data->to = fopen(task->dst.name, "wb");
-        if (!data->to)
+        data->to = open(task->dst.name, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+        if (data->to < 0)
           _E_FM_OP_ERROR_SEND_WORK(task, E_FM_OP_ERROR, "Cannot open file '%s' for writing: %s.", task->dst.name);
         _e_fm_op_copy_stat_info(task);
      }
@@ -1385,12 +1674,77 @@ _e_fm_op_open_files(E_Fm_Op_Task *task)
    return 0;
 }
 
+/* Copies up to len bytes between the two files with the cheapest method
+ * that works for them: copy_file_range() lets the kernel (or the fs -
+ * reflinks, server side copies) do it all, sendfile() at least avoids the
+ * trip through userspace, and plain read()/write() through buf is the last
+ * resort. Returns the number of bytes copied, 0 at the end of the file or
+ * -1 with errno set. Safe to call from a thread. */
+static ssize_t
+_e_fm_op_copy_data(E_Fm_Op_Copy_Data *data, size_t len, char *buf, size_t buf_size)
+{
+   ssize_t n, w, done;
+
+#ifdef HAVE_COPY_FILE_RANGE
+   if (data->method == COPY_METHOD_RANGE)
+     {
+        n = copy_file_range(data->from, NULL, data->to, NULL, len, 0);
+        /* some pseudo filesystems claim to be empty here - so only trust
+         * an eof once something was copied */
+        if ((n > 0) || ((n == 0) && (data->copied > 0)))
+          {
+             data->copied += n;
+             return n;
+          }
+        if ((n < 0) && (errno != ENOSYS) && (errno != EXDEV) &&
+            (errno != EINVAL) && (errno != EOPNOTSUPP) && (errno != EBADF))
+          return -1;
+     }
+#endif
+   if (data->method == COPY_METHOD_RANGE)
+     data->method = COPY_METHOD_SENDFILE;
+#ifdef HAVE_SYS_SENDFILE_H
+   if (data->method == COPY_METHOD_SENDFILE)
+     {
+        n = sendfile(data->to, data->from, NULL, len);
+        if ((n > 0) || ((n == 0) && (data->copied > 0)))
+          {
+             data->copied += n;
+             return n;
+          }
+        if ((n < 0) && (errno != ENOSYS) && (errno != EINVAL))
+          return -1;
+     }
+#endif
+   data->method = COPY_METHOD_RW;
+
+   if (len > buf_size) len = buf_size;
+   do
+     n = read(data->from, buf, len);
+   while ((n < 0) && (errno == EINTR));
+   if (n <= 0) return n;
+   for (done = 0; done < n; done += w)
+     {
+        w = write(data->to, buf + done, n - done);
+        if (w < 0)
+          {
+             if (errno == EINTR)
+               {
+                  w = 0;
+                  continue;
+               }
+             return -1;
+          }
+     }
+   data->copied += n;
+   return n;
+}
+
 static int
 _e_fm_op_copy_chunk(E_Fm_Op_Task *task)
 {
    E_Fm_Op_Copy_Data *data;
-   size_t dread, dwrite;
-   char buf[COPYBUFSIZE];
+   ssize_t dcopy;
 
    data = task->data;
 
@@ -1402,16 +1756,23 @@ _e_fm_op_copy_chunk(E_Fm_Op_Task *task)
         return 1;
      }
 
-   dread = fread(buf, 1, sizeof(buf), data->from);
-   if (dread == 0)
+   if (!_e_fm_op_copy_buf)
      {
-        if (!feof(data->from))
-          _E_FM_OP_ERROR_SEND_WORK(task, E_FM_OP_ERROR, "Cannot read data from '%s': %s.", task->dst.name);
+        if (posix_memalign((void **)&_e_fm_op_copy_buf, 4096, COPYBUFSIZE))
+          _e_fm_op_copy_buf = NULL;
+        if (!_e_fm_op_copy_buf)
+          _E_FM_OP_ERROR_SEND_WORK(task, E_FM_OP_ERROR, "Cannot copy '%s': %s.", task->src.name);
+     }
 
-        fclose(data->from);
-        fclose(data->to);
-        data->to = NULL;
-        data->from = NULL;
+   dcopy = _e_fm_op_copy_data(data, COPYCHUNKSIZE, _e_fm_op_copy_buf, COPYBUFSIZE);
+   if (dcopy < 0)
+     _E_FM_OP_ERROR_SEND_WORK(task, E_FM_OP_ERROR, "Cannot copy data from '%s': %s.", task->src.name);
+   if (dcopy == 0)
+     {
+        close(data->from);
+        close(data->to);
+        data->to = -1;
+        data->from = -1;
 
         _e_fm_op_copy_stat_info(task);
 
@@ -1424,15 +1785,117 @@ _e_fm_op_copy_chunk(E_Fm_Op_Task *task)
         return 1;
      }
 
-   dwrite = fwrite(buf, 1, dread, data->to);
+   task->dst.done += dcopy;
+   _e_fm_op_update_progress(task, dcopy, 0);
 
-   if (dwrite < dread)
-     _E_FM_OP_ERROR_SEND_WORK(task, E_FM_OP_ERROR, "Cannot write data to '%s': %s.", task->dst.name);
+   return 0;
+}
+
+/* Small files are dominated by open/close and metadata latency rather
+ * than bandwidth, so a run of them is copied by a few threads at once
+ * ahead of the work idler. A copier either copies the whole file or
+ * removes what it wrote again, in which case the work idler copies the
+ * file itself later and reports any error the usual way. */
+static void
+_e_fm_op_copy_thread(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   E_Fm_Op_Task *task = data;
+   E_Fm_Op_Copy_Data cd;
+   char *buf;
+   ssize_t n;
+
+   task->copier_failed = 1;
+   buf = malloc(COPYSMALLSIZE);
+   if (!buf) return;
+   cd.method = COPY_METHOD_RANGE;
+   cd.copied = 0;
+   cd.from = open(task->src.name, O_RDONLY | O_CLOEXEC);
+   if (cd.from < 0)
+     {
+        free(buf);
+        return;
+     }
+   cd.to = open(task->dst.name, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+   if (cd.to < 0)
+     {
+        close(cd.from);
+        free(buf);
+        return;
+     }
+   do
+     n = _e_fm_op_copy_data(&cd, COPYSMALLSIZE, buf, COPYSMALLSIZE);
+   while ((n > 0) && (!_e_fm_op_abort));
+   close(cd.from);
+   if ((close(cd.to) < 0) || (n < 0) || (_e_fm_op_abort))
+     unlink(task->dst.name);
+   else
+     task->copier_failed = 0;
+   free(buf);
+}
 
-   task->dst.done += dread;
-   _e_fm_op_update_progress(task, dwrite, 0);
+static void
+_e_fm_op_copy_thread_end(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   E_Fm_Op_Task *task = data;
 
-   return 0;
+   task->copier = NULL;
+   _e_fm_op_copiers--;
+   if (task->orphan)
+     {
+        if (!task->copier_failed) unlink(task->dst.name);
+        _e_fm_op_task_free(task);
+     }
+   else if (!task->copier_failed)
+     {
+        _e_fm_op_copy_stat_info(task);
+        task->dst.done += task->src.st.st_size;
+        _e_fm_op_update_progress(task, task->src.st.st_size, 0);
+        task->finished = 1;
+     }
+   /* the work idler may be waiting on this one */
+   if (!_e_fm_op_work_idler_p)
+     _e_fm_op_work_idler_p = ecore_idler_add(_e_fm_op_work_idler, NULL);
+}
+
+static void
+_e_fm_op_copy_thread_cancel(void *data, Ecore_Thread *thread)
+{
+   E_Fm_Op_Task *task = data;
+
+   task->copier_failed = 1;
+   _e_fm_op_copy_thread_end(task, thread);
+}
+
+static void
+_e_fm_op_copy_dispatch(Eina_List *node)
+{
+   E_Fm_Op_Task *t;
+   Ecore_Thread *th;
+   struct stat st;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(node, l, t)
+     {
+        if (_e_fm_op_copiers >= _e_fm_op_threads_max) break;
+        /* the separator - removes must wait for all copies */
+        if (!t) break;
+        if ((t->copier) || (t->finished)) continue;
+        if ((t->started) || (t->data) || (t->type != E_FM_OP_COPY) ||
+            (!S_ISREG(t->src.st.st_mode)) ||
+            (t->src.st.st_size > COPYSMALLSIZE))
+          break;
+        if (_e_fm_op_abort) break;
+        /* anything that needs an overwrite question goes the slow way */
+        if ((lstat(t->dst.name, &st) == 0) || (errno != ENOENT)) break;
+        t->started = 1;
+        _e_fm_op_copiers++;
+        th = ecore_thread_run(_e_fm_op_copy_thread,
+                              _e_fm_op_copy_thread_end,
+                              _e_fm_op_copy_thread_cancel, t);
+        /* if ecore could not start it, the cancel cb already ran */
+        if (!th) break;
+        t->copier = th;
+     }
 }
 
 /*
@@ -1461,10 +1924,12 @@ _e_fm_op_copy_atom(E_Fm_Op_Task *task)
    E_Fm_Op_Copy_Data *data;
 
    if (!task) return 1;
+   /* a copier thread already did it all */
+   if (task->finished) return 1;
 
    data = task->data;
 
-   if ((!data) || (!data->to) || (!data->from)) /* Did not touch the files yet. */
+   if ((!data) || (data->to < 0) || (data->from < 0)) /* Did not touch the files yet. */
      {
         E_FM_OP_DEBUG("Copy: %s --> %s\n", task->src.name, task->dst.name);
 
@@ -54,7 +54,8 @@ typedef enum _E_Fm_Op_Type
    E_FM_OP_SECURE_REMOVE,
    E_FM_OP_DESTROY,
    E_FM_OP_VOLUME_LIST_DONE,
-   E_FM_OP_INIT
+   E_FM_OP_INIT,
+   E_FM_OP_FILE_ADD_BATCH
 } E_Fm_Op_Type;
 
 #else
@@ -149,6 +149,7 @@
 #include "e_comp.h"
 #include "e_comp_cfdata.h"
 #include "e_comp_canvas.h"
+#include "e_comp_trace.h"
 #include "e_utils.h"
 #include "e_hints.h"
 #include "e_comp_x_randr.h"
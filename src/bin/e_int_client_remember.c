@@ -403,7 +403,7 @@ _check_matches(E_Remember *rem, int update)
 
         if (update)
           {
-             ec->changed = 1;
+             EC_CHANGED(ec);
              ec->changes.icon = 1;
           }
         else if (n > 1)
@@ -535,6 +535,7 @@ _advanced_apply_data(E_Config_Dialog *cfd EINA_UNUSED, E_Config_Dialog_Data *cfd
                rem->transient = 0;
           }
      }
+   e_remember_rules_changed();
 
    if (!rem->match)
      {
@@ -9,17 +9,46 @@
 
 #define TS_DO
 #ifdef TS_DO
-# define TS(x)                                                    \
-  {                                                               \
-     t1 = ecore_time_unix_get();                                  \
-     printf("ESTART: %1.5f [%1.5f] - %s\n", t1 - t0, t1 - t2, x); \
-     t2 = t1;                                                     \
-  }
-static double t0, t1, t2;
+# define TS(x) _e_main_ts_record(x)
 #else
 # define TS(x)
 #endif
 
+/* startup steps are recorded from the very first instruction of main(),
+ * before eina is up, so they live in a fixed table and are only written out
+ * (see E_START_PROFILE) once the first composited frame has been drawn */
+#define TS_MAX      1024
+#define TS_NAME_MAX 64
+
+typedef struct _E_Main_Step
+{
+   char   name[TS_NAME_MAX];
+   double at;
+   double duration;
+} E_Main_Step;
+
+/* disk reads that would otherwise happen lazily further down the init
+ * sequence; each is started on a worker thread as soon as the step it
+ * depends on (after) has been recorded, so they run alongside the rest of
+ * init, which has to stay on the main loop */
+typedef struct _E_Main_Prefetch
+{
+   const char   *name;
+   const char   *after;
+   Eina_List  *(*paths_get)(void);
+   Eina_List    *paths;
+   Ecore_Thread *thread;
+   double        start, end;
+   unsigned int  count;
+   unsigned long long bytes;
+   Eina_Bool     started : 1;
+   Eina_Bool     done : 1;
+} E_Main_Prefetch;
+
+static E_Main_Step _e_main_steps[TS_MAX];
+static unsigned int _e_main_steps_num = 0;
+static double t0, t1, t2;
+
 /*
  * i need to make more use of these when i'm baffled as to when something is
  * up. other hooks:
@@ -88,6 +117,13 @@ static void      _e_main_modules_load(Eina_Bool safe_mode);
 static Eina_Bool _e_main_cb_idle_before(void *data EINA_UNUSED);
 static Eina_Bool _e_main_cb_idle_after(void *data EINA_UNUSED);
 static Eina_Bool _e_main_cb_startup_fake_end(void *data EINA_UNUSED);
+static void      _e_main_ts_record(const char *str);
+static Eina_Bool _e_main_cb_modules_init_end(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_UNUSED);
+static int       _e_main_prefetch_shutdown(void);
+static Eina_List *_e_main_prefetch_efreet_paths(void);
+static Eina_List *_e_main_prefetch_fileman_paths(void);
+static Eina_List *_e_main_prefetch_config_paths(void);
+static Eina_List *_e_main_prefetch_theme_paths(void);
 
 /* local variables */
 static Eina_Bool really_know = EINA_FALSE;
@@ -103,6 +139,19 @@ static Ecore_Idle_Enterer *_idle_after = NULL;
 
 static Ecore_Event_Handler *mod_init_end = NULL;
 
+static Eina_Bool _e_main_prefetch_enabled = EINA_FALSE;
+static Eina_Bool _e_main_first_frame = EINA_FALSE;
+static Eina_Bool _e_main_profile_done = EINA_FALSE;
+static Ecore_Event_Handler *_e_main_profile_handler = NULL;
+static E_Main_Prefetch _e_main_prefetch[] =
+{
+   { "theme", "E Paths Init Done", _e_main_prefetch_theme_paths, NULL, NULL, 0.0, 0.0, 0, 0, 0, 0 },
+   { "config", "E_Config Init Done", _e_main_prefetch_config_paths, NULL, NULL, 0.0, 0.0, 0, 0, 0, 0 },
+   { "fileman", "E Directories Init Done", _e_main_prefetch_fileman_paths, NULL, NULL, 0.0, 0.0, 0, 0, 0, 0 },
+   { "efreet", "EIO Init Done", _e_main_prefetch_efreet_paths, NULL, NULL, 0.0, 0.0, 0, 0, 0, 0 },
+   { NULL, NULL, NULL, NULL, NULL, 0.0, 0.0, 0, 0, 0, 0 }
+};
+
 /* external variables */
 E_API Eina_Bool e_precache_end = EINA_FALSE;
 E_API Eina_Bool x_fatal = EINA_FALSE;
@@ -189,48 +238,249 @@ _xdg_data_dirs_augment(void)
      }
 }
 
-static Eina_Bool
-_precache_file(const Eina_Hash *hash EINA_UNUSED, const void *key, void *data EINA_UNUSED, void *fdata)
+static void
+_e_main_prefetch_read(E_Main_Prefetch *pf, const char *path)
 {
-   Eina_List **precache_files = fdata;
-   *precache_files = eina_list_append(*precache_files, strdup(key));
-   return EINA_TRUE;
+   unsigned char buf[4096];
+   FILE *f;
+   size_t sz;
+
+   f = fopen(path, "r");
+   if (!f) return;
+   pf->count++;
+   while ((sz = fread(buf, 1, sizeof(buf), f)) > 0)
+     pf->bytes += sz;
+   fclose(f);
 }
 
-static void *
-_precache_thread(void *data, Eina_Thread thr EINA_UNUSED)
+static void
+_e_main_prefetch_thread(void *data, Ecore_Thread *th)
 {
-   Eina_List *precache_files = data;
-   char *path;
-   double t = ecore_time_get();
-   unsigned int sum = 0;
-   unsigned int reads = 0;
+   E_Main_Prefetch *pf = data;
+   const Eina_File_Direct_Info *info;
+   Eina_Iterator *it;
+   const char *path;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(pf->paths, l, path)
+     {
+        if (ecore_thread_check(th)) break;
+        if (!ecore_file_is_dir(path))
+          {
+             _e_main_prefetch_read(pf, path);
+             continue;
+          }
+        /* directories are read one level deep only */
+        it = eina_file_direct_ls(path);
+        if (!it) continue;
+        EINA_ITERATOR_FOREACH(it, info)
+          {
+             if (ecore_thread_check(th)) break;
+             if ((info->type == EINA_FILE_REG) ||
+                 (info->type == EINA_FILE_UNKNOWN))
+               _e_main_prefetch_read(pf, info->path);
+          }
+        eina_iterator_free(it);
+     }
+   pf->end = ecore_time_unix_get();
+}
+
+static void
+_e_main_prefetch_end(void *data, Ecore_Thread *th EINA_UNUSED)
+{
+   E_Main_Prefetch *pf = data;
+
+   pf->thread = NULL;
+   pf->done = EINA_TRUE;
+   E_FREE_LIST(pf->paths, eina_stringshare_del);
+}
+
+static void
+_e_main_prefetch_cancel(void *data, Ecore_Thread *th EINA_UNUSED)
+{
+   E_Main_Prefetch *pf = data;
 
+   pf->thread = NULL;
+   E_FREE_LIST(pf->paths, eina_stringshare_del);
+}
+
+static void
+_e_main_prefetch_start(const char *step)
+{
+   E_Main_Prefetch *pf;
 
-   printf("PRECACHE: BEGIN\n");
-   EINA_LIST_FREE(precache_files, path)
+   if (!_e_main_prefetch_enabled) return;
+   for (pf = _e_main_prefetch; pf->name; pf++)
      {
-        double tt = ecore_time_get();
-        FILE *f = fopen(path, "r");
-        unsigned char buf[4096];
+        if ((pf->started) || (strcmp(pf->after, step))) continue;
+        pf->started = EINA_TRUE;
+        pf->paths = pf->paths_get();
+        if (!pf->paths) continue;
+        pf->start = ecore_time_unix_get();
+        pf->thread = ecore_thread_run(_e_main_prefetch_thread,
+                                      _e_main_prefetch_end,
+                                      _e_main_prefetch_cancel, pf);
+     }
+}
 
-        if (f)
-          {
-             size_t sz;
+static int
+_e_main_prefetch_shutdown(void)
+{
+   E_Main_Prefetch *pf;
+
+   for (pf = _e_main_prefetch; pf->name; pf++)
+     if (pf->thread) ecore_thread_cancel(pf->thread);
+   return 1;
+}
+
+static Eina_List *
+_e_main_prefetch_efreet_paths(void)
+{
+   const char *home = efreet_cache_home_get();
+   char buf[PATH_MAX];
+
+   if (!home) return NULL;
+   snprintf(buf, sizeof(buf), "%s/efreet", home);
+   return eina_list_append(NULL, eina_stringshare_add(buf));
+}
+
+static Eina_List *
+_e_main_prefetch_fileman_paths(void)
+{
+   char buf[PATH_MAX];
+
+   e_user_dir_concat_static(buf, "fileman");
+   return eina_list_append(NULL, eina_stringshare_add(buf));
+}
+
+static Eina_List *
+_e_main_prefetch_config_paths(void)
+{
+   char buf[PATH_MAX];
+
+   /* every config domain of the active profile that modules, bindings,
+    * shelves etc. load later on */
+   e_user_dir_snprintf(buf, sizeof(buf), "config/%s", e_config_profile_get());
+   return eina_list_append(NULL, eina_stringshare_add(buf));
+}
+
+static Eina_Bool
+_e_main_prefetch_theme_path(const Eina_Hash *hash EINA_UNUSED, const void *key, void *data EINA_UNUSED, void *fdata)
+{
+   Eina_List **paths = fdata;
+   *paths = eina_list_append(*paths, eina_stringshare_add(key));
+   return EINA_TRUE;
+}
+
+static Eina_List *
+_e_main_prefetch_theme_paths(void)
+{
+   const Eina_List *l;
+   const Eina_List *theme_items = elm_theme_list_get(NULL);
+   Eina_List *paths = NULL;
+   Eina_Hash *files = eina_hash_string_superfast_new(NULL);
+   const char *s;
+   int scr, dx, dy;
 
-             while ((sz = fread(buf, 1, sizeof(buf), f)) > 0)
+   // find all theme edj files to precache
+   EINA_LIST_FOREACH(theme_items, l, s)
+     {
+        Eina_Bool search = EINA_FALSE;
+        char *path = elm_theme_list_item_path_get(s, &search);
+        if (path)
+          {
+             eina_hash_del(files, path, files);
+             eina_hash_add(files, path, files);
+             free(path);
+          }
+     }
+   // go over the first 4 screens and all desks and find possible
+   // background files and add them to our hash to precache
+   for (scr = 0; scr < 4; scr++)
+     {
+        for (dy = 0; dy < e_config->zone_desks_y_count; dy++)
+          {
+             for (dx = 0; dx < e_config->zone_desks_x_count; dx++)
                {
-                  reads ++;
-                  sum = ((sum << 1) ^ buf[0]) + reads;
+                  const char *bgfile = e_bg_file_get(scr, dx, dy);
+                  eina_hash_del(files, bgfile, files);
+                  eina_hash_add(files, bgfile, files);
+                  eina_stringshare_del(bgfile);
                }
-             fclose(f);
           }
-        printf("PRECACHE: [%1.5f] [%s] DONE\n", ecore_time_get() - tt, path);
-        free(path);
      }
-   printf("PRECACHE: TOTAL [%1.5f]\n", ecore_time_get() - t);
-   printf("PRECACHE: SUM=%08x, READS=%i\n", sum, reads);
-   return NULL;
+   eina_hash_foreach(files, _e_main_prefetch_theme_path, &paths);
+   eina_hash_free(files);
+   return paths;
+}
+
+static void
+_e_main_ts_record(const char *str)
+{
+   E_Main_Step *st;
+
+   t1 = ecore_time_unix_get();
+   if (_e_main_steps_num < TS_MAX)
+     {
+        st = &_e_main_steps[_e_main_steps_num++];
+        snprintf(st->name, sizeof(st->name), "%s", str);
+        st->at = t1 - t0;
+        st->duration = t1 - t2;
+     }
+   t2 = t1;
+   _e_main_prefetch_start(str);
+}
+
+static void
+_e_main_profile_write(void)
+{
+   const char *file = getenv("E_START_PROFILE");
+   E_Main_Prefetch *pf;
+   const Eina_List *l;
+   E_Module *m;
+   unsigned int i;
+   FILE *f;
+
+   /* modules held back until after the first frame are part of startup */
+   if ((_e_main_profile_done) || (!_e_main_first_frame) ||
+       (e_module_loading_get()))
+     return;
+   _e_main_profile_done = EINA_TRUE;
+   if ((!file) || (!file[0])) return;
+   if (!strcmp(file, "-")) f = stdout;
+   else f = fopen(file, "w");
+   if (!f)
+     {
+        ERR("Can't write startup profile to '%s'", file);
+        return;
+     }
+   /* tab separated: kind, name, start and duration in seconds relative to
+    * process start, then kind specific columns (files and bytes read for
+    * prefetch, load priority for module) */
+   fprintf(f, "# enlightenment startup profile 1\n");
+   for (i = 0; i < _e_main_steps_num; i++)
+     fprintf(f, "step\t%s\t%1.6f\t%1.6f\n", _e_main_steps[i].name,
+             _e_main_steps[i].at, _e_main_steps[i].duration);
+   for (pf = _e_main_prefetch; pf->name; pf++)
+     {
+        if (!pf->start) continue;
+        /* still running: duration -1, counters are the thread's own */
+        if (pf->done)
+          fprintf(f, "prefetch\t%s\t%1.6f\t%1.6f\t%u\t%llu\n", pf->name,
+                  pf->start - t0, pf->end - pf->start, pf->count, pf->bytes);
+        else
+          fprintf(f, "prefetch\t%s\t%1.6f\t-1\t0\t0\n", pf->name,
+                  pf->start - t0);
+     }
+   EINA_LIST_FOREACH(e_module_list(), l, m)
+     {
+        if (!m->load_start) continue;
+        fprintf(f, "module\t%s\t%1.6f\t%1.6f\t%i\n", m->name,
+                m->load_start - t0, m->load_time,
+                e_module_priority_get(m->name));
+     }
+   if (f == stdout) fflush(f);
+   else fclose(f);
 }
 
 /* externally accessible functions */
@@ -307,15 +557,6 @@ main(int argc, char **argv)
         e_error_message_show(_("Enlightenment could not create a logging domain!\n"));
         _e_main_shutdown(-1);
      }
-#ifdef TS_DO
-#undef TS
-# define TS(x)                                                    \
-  {                                                               \
-     t1 = ecore_time_unix_get();                                  \
-     printf("ESTART: %1.5f [%1.5f] - %s\n", t1 - t0, t1 - t2, x); \
-     t2 = t1;                                                     \
-  }
-#endif
    TS("Eina Init Done");
    _e_main_shutdown_push(e_log_shutdown);
 
@@ -381,6 +622,7 @@ main(int argc, char **argv)
      }
    TS("Ecore Init Done");
    _e_main_shutdown_push(ecore_shutdown);
+   _e_main_shutdown_push(_e_main_prefetch_shutdown);
 
    TS("E Comp Canvas Intercept Init");
    e_comp_canvas_intercept();
@@ -391,6 +633,7 @@ main(int argc, char **argv)
      e_first_frame_start_time = ecore_time_get();
    else
      e_first_frame = NULL;
+   _e_main_prefetch_enabled = !getenv("E_NO_PRECACHE");
 
    TS("EFX Init");
    if (!e_efx_init())
@@ -629,53 +872,6 @@ main(int argc, char **argv)
    TS("E Paths Init Done");
    _e_main_shutdown_push(_e_main_path_shutdown);
 
-   TS("E_Precache");
-   if (!getenv("E_NO_PRECACHE"))
-     {
-        const Eina_List *l;
-        const Eina_List *theme_items = elm_theme_list_get(NULL);
-        Eina_List *precache_files = NULL;
-        Eina_Hash *files = eina_hash_string_superfast_new(NULL);
-        Eina_Thread thr;
-        int scr, dx, dy;
-        // find all theme edj files to precache
-        EINA_LIST_FOREACH(theme_items, l, s)
-          {
-             Eina_Bool search = EINA_FALSE;
-             char *path = elm_theme_list_item_path_get(s, &search);
-             if (path)
-               {
-                  eina_hash_del(files, path, files);
-                  eina_hash_add(files, path, files);
-                  free(path);
-               }
-          }
-        // go over the first 4 screens and all desks and find possible
-        // background files and add them to our hash to precache
-        for (scr = 0; scr < 4; scr++)
-          {
-             for (dy = 0; dy < e_config->zone_desks_y_count; dy++)
-               {
-                  for (dx = 0; dx < e_config->zone_desks_x_count; dx++)
-                    {
-                       const char *bgfile = e_bg_file_get(scr, dx, dy);
-                       eina_hash_del(files, bgfile, files);
-                       eina_hash_add(files, bgfile, files);
-                       eina_stringshare_del(bgfile);
-                    }
-               }
-          }
-        eina_hash_foreach(files, _precache_file, &precache_files);
-        eina_hash_free(files);
-        printf("PRECACHE: SPAWN\n");
-        if (!eina_thread_create(&thr, EINA_THREAD_BACKGROUND, -1,
-                                _precache_thread, precache_files))
-          {
-             ERR("Can't spawn file precache thread");
-          }
-     }
-   TS("E_Precache Done");
-
    TS("E_Ipc Init");
    if (!e_ipc_init()) _e_main_shutdown(-1);
    TS("E_Ipc Init Done");
@@ -1056,6 +1252,8 @@ main(int argc, char **argv)
    TS("E_Test Done");
 
    TS("Load Modules");
+   _e_main_profile_handler =
+     ecore_event_handler_add(E_EVENT_MODULE_INIT_END, _e_main_cb_modules_init_end, NULL);
    _e_main_modules_load(safe_mode);
    TS("Load Modules Done");
 
@@ -1117,12 +1315,28 @@ main(int argc, char **argv)
 E_API double
 e_main_ts(const char *str)
 {
-   double ret;
-   t1 = ecore_time_unix_get();
-   printf("ESTART: %1.5f [%1.5f] - %s\n", t1 - t0, t1 - t2, str);
-   ret = t1 - t2;
-   t2 = t1;
-   return ret;
+   double t = t2;
+
+   _e_main_ts_record(str);
+   return t2 - t;
+}
+
+EINTERN void
+e_main_first_frame_done(void)
+{
+   if (_e_main_first_frame) return;
+   _e_main_first_frame = EINA_TRUE;
+   TS("First Frame");
+   e_module_first_frame();
+   _e_main_profile_write();
+}
+
+static Eina_Bool
+_e_main_cb_modules_init_end(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_UNUSED)
+{
+   _e_main_profile_write();
+   E_FREE_FUNC(_e_main_profile_handler, ecore_event_handler_del);
+   return ECORE_CALLBACK_PASS_ON;
 }
 
 /* local functions */
@@ -14,6 +14,7 @@ static void      _e_module_cb_dialog_disable(void *data, E_Dialog *dia);
 static void      _e_module_event_update_free(void *data, void *event);
 static int       _e_module_sort_name(const void *d1, const void *d2);
 static void      _e_module_whitelist_check(void);
+static void      _e_module_init_end(void);
 
 /* local subsystem globals */
 static Eina_List *_e_modules = NULL;
@@ -23,6 +24,14 @@ static Eina_Bool _e_modules_init_end = EINA_FALSE;
 
 static Eina_Hash *_e_module_path_hash = NULL;
 
+static Eina_List *_e_modules_deferred = NULL;
+static Ecore_Idler *_e_modules_deferred_idler = NULL;
+static Ecore_Timer *_e_modules_deferred_timer = NULL;
+static Eina_Hash *_e_modules_on_demand = NULL;
+static Ecore_Thread *_e_modules_preload = NULL;
+static Eina_Bool _e_modules_enabling = EINA_FALSE;
+static Eina_List *_e_modules_enabling_actions = NULL;
+
 E_API int E_EVENT_MODULE_UPDATE = 0;
 E_API int E_EVENT_MODULE_INIT_END = 0;
 
@@ -64,6 +73,125 @@ _module_is_important(const char *name)
    return EINA_FALSE;
 }
 
+static E_Config_Module *
+_e_module_config_find(const char *name)
+{
+   E_Config_Module *em;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(e_config->modules, l, em)
+     {
+        if (!em) continue;
+        if (!e_util_strcmp(em->name, name)) return em;
+     }
+   return NULL;
+}
+
+static const char *
+_e_module_path_find(const char *name)
+{
+   char buf[PATH_MAX];
+
+   if (name[0] != '/')
+     {
+        snprintf(buf, sizeof(buf), "%s/%s/module.so", name, MODULE_ARCH);
+        return e_path_find(path_modules, buf);
+     }
+   else if (eina_str_has_extension(name, ".so"))
+     return eina_stringshare_add(name);
+   return NULL;
+}
+
+static E_Module *
+_e_module_load(const char *name)
+{
+   E_Module *m;
+   double t;
+
+   e_util_env_set("E_MODULE_LOAD", name);
+   t = ecore_time_unix_get();
+   m = e_module_new(name);
+   if (!m) return NULL;
+   e_module_enable(m);
+   m->load_start = t;
+   m->load_time = ecore_time_unix_get() - t;
+   return m;
+}
+
+static void
+_e_module_preload_func(void *data, Ecore_Thread *th)
+{
+   Eina_List *l, *paths = data;
+   const char *path;
+   char buf[4096];
+   FILE *f;
+
+   /* just pull the objects into the page cache, dlopen() happens later on
+    * the main loop */
+   EINA_LIST_FOREACH(paths, l, path)
+     {
+        if (ecore_thread_check(th)) break;
+        f = fopen(path, "rb");
+        if (!f) continue;
+        while (fread(buf, 1, sizeof(buf), f) > 0) ;
+        fclose(f);
+     }
+}
+
+static void
+_e_module_preload_end(void *data, Ecore_Thread *th EINA_UNUSED)
+{
+   Eina_List *paths = data;
+
+   _e_modules_preload = NULL;
+   E_FREE_LIST(paths, eina_stringshare_del);
+}
+
+static void
+_e_module_on_demand_add(E_Config_Module *em)
+{
+   const char *action;
+   Eina_List *l;
+
+   if (!_e_modules_on_demand)
+     _e_modules_on_demand = eina_hash_string_superfast_new(EINA_FREE_CB(eina_stringshare_del));
+   EINA_LIST_FOREACH(em->actions, l, action)
+     {
+        if (eina_hash_find(_e_modules_on_demand, action)) continue;
+        eina_hash_add(_e_modules_on_demand, action, eina_stringshare_ref(em->name));
+     }
+}
+
+static Eina_Bool
+_e_module_deferred_idler(void *data EINA_UNUSED)
+{
+   E_Config_Module *em;
+   const char *name;
+
+   /* one module per idle so the desktop stays responsive meanwhile */
+   name = eina_list_data_get(_e_modules_deferred);
+   _e_modules_deferred = eina_list_remove_list(_e_modules_deferred, _e_modules_deferred);
+   /* it may have been disabled while it waited */
+   em = _e_module_config_find(name);
+   if ((em) && (em->enabled) && (!eina_hash_find(_e_modules_hash, name)))
+     _e_module_load(name);
+   eina_stringshare_del(name);
+   if (_e_modules_deferred) return ECORE_CALLBACK_RENEW;
+
+   _e_modules_deferred_idler = NULL;
+   _e_module_init_end();
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static Eina_Bool
+_e_module_deferred_timeout(void *data EINA_UNUSED)
+{
+   /* nothing got composited (yet), don't hold the modules back forever */
+   _e_modules_deferred_timer = NULL;
+   e_module_first_frame();
+   return ECORE_CALLBACK_CANCEL;
+}
+
 /* externally accessible functions */
 EINTERN int
 e_module_init(void)
@@ -106,6 +234,11 @@ e_module_shutdown(void)
           }
      }
 
+   E_FREE_FUNC(_e_modules_deferred_idler, ecore_idler_del);
+   E_FREE_FUNC(_e_modules_deferred_timer, ecore_timer_del);
+   E_FREE_LIST(_e_modules_deferred, eina_stringshare_del);
+   E_FREE_FUNC(_e_modules_preload, ecore_thread_cancel);
+   E_FREE_FUNC(_e_modules_on_demand, eina_hash_free);
    E_FREE_FUNC(_e_module_path_hash, eina_hash_free);
    E_FREE_FUNC(_e_modules_hash, eina_hash_free);
 
@@ -115,8 +248,9 @@ e_module_shutdown(void)
 E_API void
 e_module_all_load(void)
 {
-   Eina_List *l, *ll;
+   Eina_List *l, *ll, *preload = NULL;
    E_Config_Module *em, *em2;
+   const char *path;
    char buf[128];
 
    _e_modules_initting = EINA_TRUE;
@@ -133,6 +267,7 @@ e_module_all_load(void)
         if (!strcmp(em->name, em2->name))
           {
              eina_stringshare_del(em->name);
+             E_FREE_LIST(em->actions, eina_stringshare_del);
              e_config->modules = eina_list_remove_list(e_config->modules, l);
              free(em);
           }
@@ -145,29 +280,43 @@ e_module_all_load(void)
         if (_module_is_nosave(em->name))
           {
              eina_stringshare_del(em->name);
+             E_FREE_LIST(em->actions, eina_stringshare_del);
              e_config->modules = eina_list_remove_list(e_config->modules, l);
              free(em);
              continue;
           }
         if (em->enabled)
           {
-             E_Module *m;
-
              if (eina_hash_find(_e_modules_hash, em->name)) continue;
 
-             e_util_env_set("E_MODULE_LOAD", em->name);
-             snprintf(buf, sizeof(buf), _("Loading Module: %s"), em->name);
+             /* its actions pull a module in early when they are used. an
+              * on-demand module that never registered an action could
+              * never be triggered, so treat it as after-first-frame */
+             if ((em->priority != E_MODULE_PRIORITY_CRITICAL) &&
+                 (!_module_is_important(em->name)))
+               {
+                  if (em->actions) _e_module_on_demand_add(em);
+                  if ((em->priority != E_MODULE_PRIORITY_ON_DEMAND) ||
+                      (!em->actions))
+                    _e_modules_deferred = eina_list_append(_e_modules_deferred,
+                                                           eina_stringshare_ref(em->name));
+                  path = _e_module_path_find(em->name);
+                  if (path) preload = eina_list_append(preload, path);
+                  continue;
+               }
 
-             m = e_module_new(em->name);
-             if (m) e_module_enable(m);
+             snprintf(buf, sizeof(buf), _("Loading Module: %s"), em->name);
+             _e_module_load(em->name);
           }
      }
-   ecore_event_add(E_EVENT_MODULE_INIT_END, NULL, NULL, NULL);
-   _e_modules_init_end = EINA_TRUE;
-   _e_modules_initting = EINA_FALSE;
-   _e_module_whitelist_check();
-
-   unsetenv("E_MODULE_LOAD");
+   if (preload)
+     _e_modules_preload = ecore_thread_run(_e_module_preload_func,
+                                           _e_module_preload_end,
+                                           _e_module_preload_end, preload);
+   if (_e_modules_deferred)
+     _e_modules_deferred_timer = ecore_timer_loop_add(5.0, _e_module_deferred_timeout, NULL);
+   else
+     _e_module_init_end();
 }
 
 E_API Eina_Bool
@@ -176,6 +325,67 @@ e_module_loading_get(void)
    return !_e_modules_init_end;
 }
 
+E_API void
+e_module_priority_set(E_Module *m, E_Module_Priority priority)
+{
+   E_Config_Module *em;
+
+   E_OBJECT_CHECK(m);
+   E_OBJECT_TYPE_CHECK(m, E_MODULE_TYPE);
+   em = _e_module_config_find(m->name);
+   if ((!em) || (em->priority == priority)) return;
+   em->priority = priority;
+   if (priority == E_MODULE_PRIORITY_CRITICAL)
+     E_FREE_LIST(em->actions, eina_stringshare_del);
+   e_config_save_queue();
+}
+
+E_API E_Module_Priority
+e_module_priority_get(const char *name)
+{
+   E_Config_Module *em;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(name, E_MODULE_PRIORITY_CRITICAL);
+   em = _e_module_config_find(name);
+   return em ? em->priority : E_MODULE_PRIORITY_CRITICAL;
+}
+
+EINTERN void
+e_module_first_frame(void)
+{
+   E_FREE_FUNC(_e_modules_deferred_timer, ecore_timer_del);
+   if ((_e_modules_deferred) && (!_e_modules_deferred_idler))
+     _e_modules_deferred_idler = ecore_idler_add(_e_module_deferred_idler, NULL);
+}
+
+EINTERN void
+e_module_action_register(const char *action)
+{
+   if (!_e_modules_enabling) return;
+   _e_modules_enabling_actions =
+     eina_list_append(_e_modules_enabling_actions, eina_stringshare_add(action));
+}
+
+EINTERN Eina_Bool
+e_module_action_load(const char *action)
+{
+   E_Config_Module *em;
+   const char *name;
+   E_Module *m = NULL;
+
+   if ((!_e_modules_on_demand) || (!action)) return EINA_FALSE;
+   name = eina_hash_find(_e_modules_on_demand, action);
+   if (!name) return EINA_FALSE;
+   name = eina_stringshare_ref(name);
+   eina_hash_del_by_key(_e_modules_on_demand, action);
+   em = _e_module_config_find(name);
+   if ((em) && (em->enabled) && (!eina_hash_find(_e_modules_hash, name)))
+     m = _e_module_load(name);
+   if (!_e_modules_initting) unsetenv("E_MODULE_LOAD");
+   eina_stringshare_del(name);
+   return (m) && (m->enabled);
+}
+
 E_API E_Module *
 e_module_new(const char *name)
 {
@@ -190,13 +400,8 @@ e_module_new(const char *name)
    if (eina_hash_find(_e_modules_hash, name)) return NULL;
 
    m = E_OBJECT_ALLOC(E_Module, E_MODULE_TYPE, _e_module_free);
-   if (name[0] != '/')
-     {
-        snprintf(buf, sizeof(buf), "%s/%s/module.so", name, MODULE_ARCH);
-        modpath = e_path_find(path_modules, buf);
-     }
-   else if (eina_str_has_extension(name, ".so"))
-     modpath = eina_stringshare_add(name);
+   snprintf(buf, sizeof(buf), "%s/%s/module.so", name, MODULE_ARCH);
+   modpath = _e_module_path_find(name);
    if (!modpath)
      {
         snprintf(body, sizeof(body),
@@ -295,6 +500,7 @@ init_done:
                }
           }
      }
+   in_list = !!_e_module_config_find(m->name);
    if (!in_list)
      {
         E_Config_Module *module;
@@ -332,11 +538,21 @@ e_module_enable(E_Module *m)
    Eina_List *l;
    E_Event_Module_Update *ev;
    E_Config_Module *em;
+   Eina_List *actions, *prev_actions;
+   Eina_Bool prev_enabling;
 
    E_OBJECT_CHECK_RETURN(m, 0);
    E_OBJECT_TYPE_CHECK_RETURN(m, E_MODULE_TYPE, 0);
    if ((m->enabled) || (m->error)) return 0;
+   /* remember the actions it registers in case it is loaded late */
+   prev_enabling = _e_modules_enabling;
+   prev_actions = _e_modules_enabling_actions;
+   _e_modules_enabling = EINA_TRUE;
+   _e_modules_enabling_actions = NULL;
    m->data = m->func.init(m);
+   actions = _e_modules_enabling_actions;
+   _e_modules_enabling = prev_enabling;
+   _e_modules_enabling_actions = prev_actions;
    if (m->data)
      {
         m->enabled = 1;
@@ -346,6 +562,12 @@ e_module_enable(E_Module *m)
              if (!e_util_strcmp(em->name, m->name))
                {
                   em->enabled = 1;
+                  if ((em->priority != E_MODULE_PRIORITY_CRITICAL) && (actions))
+                    {
+                       E_FREE_LIST(em->actions, eina_stringshare_del);
+                       em->actions = actions;
+                       actions = NULL;
+                    }
                   e_config_save_queue();
 
                   ev = E_NEW(E_Event_Module_Update, 1);
@@ -356,10 +578,12 @@ e_module_enable(E_Module *m)
                   break;
                }
           }
+        E_FREE_LIST(actions, eina_stringshare_del);
         if (_e_modules_hash && (!_e_modules_initting))
           _e_module_whitelist_check();
         return 1;
      }
+   E_FREE_LIST(actions, eina_stringshare_del);
    return 0;
 }
 
@@ -551,6 +775,7 @@ _e_module_free(E_Module *m)
           {
              e_config->modules = eina_list_remove(e_config->modules, em);
              if (em->name) eina_stringshare_del(em->name);
+             E_FREE_LIST(em->actions, eina_stringshare_del);
              E_FREE(em);
              break;
           }
@@ -643,6 +868,17 @@ _e_module_sort_name(const void *d1, const void *d2)
    return strcmp(m1->name, m2->name);
 }
 
+static void
+_e_module_init_end(void)
+{
+   ecore_event_add(E_EVENT_MODULE_INIT_END, NULL, NULL, NULL);
+   _e_modules_init_end = EINA_TRUE;
+   _e_modules_initting = EINA_FALSE;
+   _e_module_whitelist_check();
+
+   unsetenv("E_MODULE_LOAD");
+}
+
 static void
 _e_module_event_update_free(void *data EINA_UNUSED, void *event)
 {
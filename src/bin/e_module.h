@@ -1,6 +1,6 @@
 #ifdef E_TYPEDEFS
 
-#define E_MODULE_API_VERSION 25
+#define E_MODULE_API_VERSION 26
 
 typedef struct _E_Module     E_Module;
 typedef struct _E_Module_Api E_Module_Api;
@@ -9,6 +9,17 @@ typedef struct _E_Event_Module_Update E_Event_Module_Update;
 
 typedef struct E_Module_Desktop E_Module_Desktop;
 
+/* when an enabled module is brought up at startup. a module declares this
+ * from its init with e_module_priority_set() and it takes effect from the
+ * next start on */
+typedef enum _E_Module_Priority
+{
+   E_MODULE_PRIORITY_CRITICAL, /* before the desktop is shown (default) */
+   E_MODULE_PRIORITY_AFTER_FIRST_FRAME, /* once the first frame is composited,
+                                         * or when one of its actions is used */
+   E_MODULE_PRIORITY_ON_DEMAND /* the first time one of its actions is used */
+} E_Module_Priority;
+
 #else
 #ifndef E_MODULE_H
 #define E_MODULE_H
@@ -44,6 +55,9 @@ struct _E_Module
    Eina_Bool        enabled E_BITFIELD;
    Eina_Bool        error E_BITFIELD;
 
+   double           load_start; // unix time init was started
+   double           load_time; // seconds spent in dlopen and init
+
    /* the module is allowed to modify these */
    void                *data;
 };
@@ -77,5 +91,11 @@ E_API Eina_List   *e_module_desktop_list(void);
 E_API void         e_module_desktop_free(E_Module_Desktop *md);
 E_API void         e_module_dialog_show(E_Module *m, const char *title, const char *body);
 E_API Eina_Bool    e_module_loading_get(void);
+E_API void         e_module_priority_set(E_Module *m, E_Module_Priority priority);
+E_API E_Module_Priority e_module_priority_get(const char *name);
+
+EINTERN void       e_module_first_frame(void);
+EINTERN void       e_module_action_register(const char *action);
+EINTERN Eina_Bool  e_module_action_load(const char *action);
 #endif
 #endif
@@ -8,12 +8,21 @@ static void            _e_msgbus_request_name_cb(void *data, const Eldbus_Messag
 static Eldbus_Message *_e_msgbus_core_version_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg);
 static Eldbus_Message *_e_msgbus_core_restart_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg);
 static Eldbus_Message *_e_msgbus_core_shutdown_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg);
+static Eldbus_Message *_e_msgbus_core_frame_trace_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg);
+static Eldbus_Message *_e_msgbus_core_frame_trace_dump_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg);
+static Eldbus_Message *_e_msgbus_core_system_stats_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg);
 
 static const Eldbus_Method core_methods[] =
 {
    { "Version", NULL, ELDBUS_ARGS({"s", "version"}), _e_msgbus_core_version_cb, 0 },
    { "Restart", NULL, NULL, _e_msgbus_core_restart_cb, 0 },
    { "Shutdown", NULL, NULL, _e_msgbus_core_shutdown_cb, 0 },
+   { "FrameTrace", ELDBUS_ARGS({"b", "enable"}), NULL, _e_msgbus_core_frame_trace_cb, 0 },
+   { "FrameTraceDump", NULL, ELDBUS_ARGS({"s", "json"}), _e_msgbus_core_frame_trace_dump_cb, 0 },
+   { "SystemStats", NULL, ELDBUS_ARGS({"d", "uptime"}, {"t", "sent"}, {"t", "received"},
+                                      {"t", "bytes_sent"}, {"t", "bytes_received"},
+                                      {"d", "rtt_last"}, {"d", "rtt_avg"}, {"d", "rtt_max"}),
+     _e_msgbus_core_system_stats_cb, 0 },
    { NULL, NULL, NULL, NULL, 0}
 };
 
@@ -127,3 +136,51 @@ _e_msgbus_core_shutdown_cb(const Eldbus_Service_Interface *iface EINA_UNUSED,
      e_sys_action_do(E_SYS_EXIT, NULL);
    return eldbus_message_method_return_new(msg);
 }
+
+static Eldbus_Message *
+_e_msgbus_core_frame_trace_cb(const Eldbus_Service_Interface *iface EINA_UNUSED,
+                              const Eldbus_Message *msg)
+{
+   Eina_Bool enable;
+
+   if (!eldbus_message_arguments_get(msg, "b", &enable))
+     return eldbus_message_error_new(msg, "org.enlightenment.wm.Core.InvalidArgs",
+                                     "Expected a boolean");
+   e_comp_trace_enabled_set(enable);
+   return eldbus_message_method_return_new(msg);
+}
+
+static Eldbus_Message *
+_e_msgbus_core_frame_trace_dump_cb(const Eldbus_Service_Interface *iface EINA_UNUSED,
+                                   const Eldbus_Message *msg)
+{
+   Eldbus_Message *reply = eldbus_message_method_return_new(msg);
+   char *json;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(reply, NULL);
+   json = e_comp_trace_json_get();
+   eldbus_message_arguments_append(reply, "s", json ? json : "");
+   free(json);
+   return reply;
+}
+
+static Eldbus_Message *
+_e_msgbus_core_system_stats_cb(const Eldbus_Service_Interface *iface EINA_UNUSED,
+                               const Eldbus_Message *msg)
+{
+   Eldbus_Message *reply = eldbus_message_method_return_new(msg);
+   const E_System_Stats *st = e_system_stats_get();
+   double uptime = 0.0;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(reply, NULL);
+   if (st->start > 0.0) uptime = ecore_time_get() - st->start;
+   eldbus_message_arguments_append(reply, "dttttddd", uptime,
+                                   (uint64_t)st->msgs_sent, (uint64_t)st->msgs_recv,
+                                   (uint64_t)st->bytes_sent, (uint64_t)st->bytes_recv,
+                                   st->rtt_last,
+                                   st->pings ? st->rtt_total / st->pings : 0.0,
+                                   st->rtt_max);
+   // refresh the round trip for the next query
+   e_system_ping();
+   return reply;
+}
@@ -15,9 +15,21 @@
 #endif
 #ifndef HAVE_WAYLAND_ONLY
 # include "e_comp_x.h"
+# include <X11/Xlib.h>
 #endif
 
 #include <sys/mman.h>
+#if defined(__SSE2__)
+# include <emmintrin.h>
+#elif defined(__ARM_NEON)
+# include <arm_neon.h>
+#endif
+
+/* rough cost of one server fetch, expressed in pixels transferred */
+#define FETCH_COST 4096
+/* extra cost of a fetch narrower than the image: mit-shm can only get whole
+ * rows directly, so partial rows go through a temporary image and a copy */
+#define FETCH_PARTIAL_COST 2048
 
 static Eina_Hash *pixmaps[2] = {NULL};
 static Eina_Hash *aliases[2] = {NULL};
@@ -58,6 +70,7 @@ struct _E_Pixmap
    Eina_Bool usable E_BITFIELD;
    Eina_Bool dirty E_BITFIELD;
    Eina_Bool image_argb E_BITFIELD;
+   Eina_Bool image_xrgb E_BITFIELD; // image is 24bit rgb in the default visual
 };
 
 #ifdef HAVE_WAYLAND
@@ -912,6 +925,23 @@ e_pixmap_image_clear(E_Pixmap *cp, Eina_Bool cache)
      }
 }
 
+#ifndef HAVE_WAYLAND_ONLY
+/* the fast xrgb converter assumes 0x00rrggbb pixels, stored little endian */
+static Eina_Bool
+_e_pixmap_visual_xrgb(Ecore_X_Visual visual)
+{
+   const union { unsigned int i; unsigned char c[4]; } host = { 1 };
+   Visual *vis = visual;
+
+   if (!vis) return EINA_FALSE;
+   if ((vis->red_mask != 0xff0000) || (vis->green_mask != 0x00ff00) ||
+       (vis->blue_mask != 0x0000ff))
+     return EINA_FALSE;
+   return (host.c[0] == 1) &&
+     (ImageByteOrder((Display *)ecore_x_display_get()) == LSBFirst);
+}
+#endif
+
 E_API Eina_Bool
 e_pixmap_image_refresh(E_Pixmap *cp)
 {
@@ -936,7 +966,11 @@ e_pixmap_image_refresh(E_Pixmap *cp)
         cp->image =
           ecore_x_image_new(cp->w, cp->h, cp->visual, cp->client->depth);
         if (cp->image)
-          cp->image_argb = ecore_x_image_is_argb32_get(cp->image);
+          {
+             cp->image_argb = ecore_x_image_is_argb32_get(cp->image);
+             cp->image_xrgb = (!cp->image_argb) && (cp->client->depth == 24) &&
+               _e_pixmap_visual_xrgb(cp->visual);
+          }
         return !!cp->image;
 #endif
         break;
@@ -1042,6 +1076,37 @@ e_pixmap_image_data_get(E_Pixmap *cp)
    return NULL;
 }
 
+#ifndef HAVE_WAYLAND_ONLY
+static void
+_e_pixmap_xrgb_convert(unsigned int *dst, const unsigned char *src, int sbpp, int w)
+{
+   int i = 0;
+
+   if (sbpp == 4)
+     {
+        const unsigned int *s = (const unsigned int *)src;
+# if defined(__SSE2__)
+        const __m128i a = _mm_set1_epi32(0xff000000);
+
+        for (; i + 4 <= w; i += 4)
+          _mm_storeu_si128((__m128i *)(dst + i),
+                           _mm_or_si128(_mm_loadu_si128((const __m128i *)(s + i)), a));
+# elif defined(__ARM_NEON)
+        const uint32x4_t a = vdupq_n_u32(0xff000000);
+
+        for (; i + 4 <= w; i += 4)
+          vst1q_u32(dst + i, vorrq_u32(vld1q_u32(s + i), a));
+# endif
+        for (; i < w; i++)
+          dst[i] = 0xff000000 | s[i];
+        return;
+     }
+   /* packed 24bpp, little endian bgr */
+   for (; i < w; i++, src += 3)
+     dst[i] = 0xff000000 | (src[2] << 16) | (src[1] << 8) | src[0];
+}
+#endif
+
 E_API Eina_Bool
 e_pixmap_image_data_argb_convert(E_Pixmap *cp, void *pix, void *ipix, Eina_Rectangle *r, int stride)
 {
@@ -1054,6 +1119,19 @@ e_pixmap_image_data_argb_convert(E_Pixmap *cp, void *pix, void *ipix, Eina_Recta
       case E_PIXMAP_TYPE_X:
         if (cp->image_argb) return EINA_TRUE;
 #ifndef HAVE_WAYLAND_ONLY
+        if (cp->image_xrgb && ((cp->ibpp == 4) || (cp->ibpp == 3)))
+          {
+             unsigned char *src = ipix;
+             unsigned char *dst = pix;
+             int y;
+
+             src += (r->y * cp->ibpl) + (r->x * cp->ibpp);
+             dst += (r->y * stride) + (r->x * 4);
+             for (y = 0; y < r->h; y++)
+               _e_pixmap_xrgb_convert((unsigned int *)(dst + (y * stride)),
+                                      src + (y * cp->ibpl), cp->ibpp, r->w);
+             return EINA_TRUE;
+          }
         return ecore_x_image_to_argb_convert(ipix, cp->ibpp, cp->ibpl,
                                              cp->cmap, cp->visual,
                                              r->x, r->y, r->w, r->h,
@@ -1093,6 +1171,101 @@ e_pixmap_image_draw(E_Pixmap *cp, const Eina_Rectangle *r)
    return EINA_FALSE;
 }
 
+#ifndef HAVE_WAYLAND_ONLY
+static int
+_e_pixmap_rect_sort_cb(const void *a, const void *b)
+{
+   const Eina_Rectangle *r1 = a, *r2 = b;
+
+   if (r1->y != r2->y) return r1->y - r2->y;
+   return r1->x - r2->x;
+}
+
+static Eina_Bool
+_e_pixmap_image_draw_band(E_Pixmap *cp, const Eina_Rectangle *rects, unsigned int num, int y, int h, unsigned int *fetches)
+{
+   unsigned int i;
+   long long area = 0, split = 0;
+
+   for (i = 0; i < num; i++)
+     {
+        area = (long long)rects[i].w * rects[i].h;
+        split += FETCH_COST + area;
+        if (rects[i].w < cp->w) split += FETCH_PARTIAL_COST;
+     }
+   /* fetch the whole band in one go if that moves fewer weighted pixels */
+   if ((num > 1) && (FETCH_COST + (long long)cp->w * h <= split))
+     {
+        (*fetches)++;
+        return ecore_x_image_get(cp->image, cp->pixmap, 0, y, 0, y, cp->w, h);
+     }
+   for (i = 0; i < num; i++)
+     {
+        (*fetches)++;
+        if (!ecore_x_image_get(cp->image, cp->pixmap, rects[i].x, rects[i].y,
+                               rects[i].x, rects[i].y, rects[i].w, rects[i].h))
+          return EINA_FALSE;
+     }
+   return EINA_TRUE;
+}
+#endif
+
+/* fetch several damage rects from the server, coalescing them into
+ * full-width bands where that needs fewer round trips than fetching each
+ * rect. rects is sorted in place; fetches returns the number of transfers */
+E_API Eina_Bool
+e_pixmap_image_draw_rects(E_Pixmap *cp, Eina_Rectangle *rects, unsigned int num, unsigned int *fetches)
+{
+   unsigned int f = 0;
+   Eina_Bool ret = EINA_TRUE;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(cp, EINA_FALSE);
+
+   switch (cp->type)
+     {
+      case E_PIXMAP_TYPE_X:
+#ifndef HAVE_WAYLAND_ONLY
+        {
+           unsigned int i, start = 0;
+           int y1, y2;
+
+           if ((!cp->image) || (!cp->pixmap)) return EINA_FALSE;
+           if (!num) break;
+           qsort(rects, num, sizeof(Eina_Rectangle), _e_pixmap_rect_sort_cb);
+           y1 = rects[0].y;
+           y2 = rects[0].y + rects[0].h;
+           for (i = 1; i <= num; i++)
+             {
+                /* join rects into a band while the rows between them cost
+                 * less than another fetch */
+                if ((i < num) &&
+                    ((long long)(rects[i].y - y2) * cp->w < FETCH_COST))
+                  {
+                     y2 = MAX(y2, rects[i].y + rects[i].h);
+                     continue;
+                  }
+                ret = _e_pixmap_image_draw_band(cp, rects + start, i - start,
+                                                y1, y2 - y1, &f);
+                if ((!ret) || (i == num)) break;
+                start = i;
+                y1 = rects[i].y;
+                y2 = rects[i].y + rects[i].h;
+             }
+        }
+#endif
+        break;
+      case E_PIXMAP_TYPE_WL:
+        (void) rects;
+        (void) num;
+        break;
+      default:
+        ret = EINA_FALSE;
+        break;
+     }
+   if (fetches) *fetches = f;
+   return ret;
+}
+
 E_API void
 e_pixmap_image_opaque_set(E_Pixmap *cp, int x, int y, int w, int h)
 {
@@ -82,33 +82,90 @@ ignore_client(const E_Client *ec, const Eina_List *skiplist)
    return EINA_FALSE;
 }
 
+/* clients which can cover a placement, taken once per placement instead of
+ * walking the whole client stack for every candidate position. a candidate
+ * only scans the clients whose left edge lies within [x - max_w, x + w), so
+ * it costs O(log n) plus that window, which is O(n) at worst when one wide
+ * client stretches the window over the whole desk
+ */
+typedef struct
+{
+   Eina_Rectangle *rects; // sorted by x
+   int             num;
+   int             max_w; // widest client, bounds how far left to look
+} E_Place_Coverage;
+
 static int
-_e_place_coverage_client_add(Eina_List *skiplist, int ar, int x, int y, int w, int h)
+_e_place_cb_rect_sort_cmp(const void *v1, const void *v2)
+{
+   const Eina_Rectangle *r1 = v1, *r2 = v2;
+
+   return r1->x - r2->x;
+}
+
+static void
+_e_place_coverage_init(E_Place_Coverage *cov, Eina_List *skiplist)
 {
    E_Client *ec;
-   int x2, y2, w2, h2;
-   int iw, ih;
-   int x0, x00, yy0, y00;
+   int alloc = 0;
 
+   cov->rects = NULL;
+   cov->num = 0;
+   cov->max_w = 0;
    E_CLIENT_REVERSE_FOREACH(ec)
      {
         if (ignore_client(ec, skiplist)) continue;
         if (ignore_client_and_break(ec)) break;
-        x2 = ec->x; y2 = ec->y; w2 = ec->w; h2 = ec->h;
-        if (E_INTERSECTS(x, y, w, h, x2, y2, w2, h2))
+        if (cov->num == alloc)
           {
-             x0 = x;
-             if (x < x2) x0 = x2;
-             x00 = (x + w);
-             if ((x2 + w2) < (x + w)) x00 = (x2 + w2);
-             yy0 = y;
-             if (y < y2) yy0 = y2;
-             y00 = (y + h);
-             if ((y2 + h2) < (y + h)) y00 = (y2 + h2);
-             iw = x00 - x0;
-             ih = y00 - yy0;
-             ar += (iw * ih);
+             alloc += 32;
+             E_REALLOC(cov->rects, Eina_Rectangle, alloc);
           }
+        EINA_RECTANGLE_SET(&cov->rects[cov->num], ec->x, ec->y, ec->w, ec->h);
+        if (ec->w > cov->max_w) cov->max_w = ec->w;
+        cov->num++;
+     }
+   if (cov->num > 1)
+     qsort(cov->rects, cov->num, sizeof(Eina_Rectangle), _e_place_cb_rect_sort_cmp);
+}
+
+/* add the area of all clients overlapping x,y wxh to ar; stops early once
+ * ar reaches limit since the caller can't use a worse result anyway
+ */
+static int
+_e_place_coverage_client_add(const E_Place_Coverage *cov, int ar, int limit, int x, int y, int w, int h)
+{
+   int lo = 0, hi = cov->num, first, i;
+
+   /* only clients starting left of the right edge can intersect */
+   while (lo < hi)
+     {
+        int mid = (lo + hi) / 2;
+
+        if (cov->rects[mid].x < x + w) lo = mid + 1;
+        else hi = mid;
+     }
+   /* and none starting a whole widest client left of x reaches it */
+   first = 0, hi = lo;
+   while (first < hi)
+     {
+        int mid = (first + hi) / 2;
+
+        if (cov->rects[mid].x + cov->max_w <= x) first = mid + 1;
+        else hi = mid;
+     }
+   for (i = first; i < lo; i++)
+     {
+        const Eina_Rectangle *r = &cov->rects[i];
+        int x0, x00, yy0, y00;
+
+        if (!E_INTERSECTS(x, y, w, h, r->x, r->y, r->w, r->h)) continue;
+        x0 = MAX(x, r->x);
+        x00 = MIN(x + w, r->x + r->w);
+        yy0 = MAX(y, r->y);
+        y00 = MIN(y + h, r->y + r->h);
+        ar += (x00 - x0) * (y00 - yy0);
+        if (ar >= limit) break;
      }
    return ar;
 }
@@ -167,8 +224,23 @@ _e_place_array_resize(int *array, int *pos, int *size)
    return array;
 }
 
+/* sort an edge array and drop duplicates, returning the new length */
+static int
+_e_place_array_uniq(int *array, int num)
+{
+   int i, n = 0;
+
+   qsort(array, num, sizeof(int), _e_place_cb_sort_cmp);
+   for (i = 0; i < num; i++)
+     {
+        if ((n > 0) && (array[n - 1] == array[i])) continue;
+        array[n++] = array[i];
+     }
+   return n;
+}
+
 static void
-_e_place_desk_region_smart_obstacle_add(char *u_x, char *u_y, int **a_x, int **a_y, int *a_w, int *a_h, int *a_alloc_w, int *a_alloc_h, int zx, int zy, int zw, int zh, int bx, int by, int bw, int bh)
+_e_place_desk_region_smart_obstacle_add(int **a_x, int **a_y, int *a_w, int *a_h, int *a_alloc_w, int *a_alloc_h, int zx, int zy, int zw, int zh, int bx, int by, int bw, int bh)
 {
    if (bx < zx)
      {
@@ -184,30 +256,14 @@ _e_place_desk_region_smart_obstacle_add(char *u_x, char *u_y, int **a_x, int **a
      }
    if ((by + bh) > zy + zh) bh = zy + zh - by;
    if (by >= zy + zh) return;
-   if (!u_x[bx])
-     {
-        *a_x = _e_place_array_resize(*a_x, a_w, a_alloc_w);
-        (*a_x)[*a_w - 1] = bx;
-        u_x[bx] = 1;
-     }
-   if (!u_x[bx + bw])
-     {
-        *a_x = _e_place_array_resize(*a_x, a_w, a_alloc_w);
-        (*a_x)[*a_w - 1] = bx + bw;
-        u_x[bx + bw] = 1;
-     }
-   if (!u_y[by])
-     {
-        *a_y = _e_place_array_resize(*a_y, a_h, a_alloc_h);
-        (*a_y)[*a_h - 1] = by;
-        u_y[by] = 1;
-     }
-   if (!u_y[by + bh])
-     {
-        *a_y = _e_place_array_resize(*a_y, a_h, a_alloc_h);
-        (*a_y)[*a_h - 1] = by + bh;
-        u_y[by + bh] = 1;
-     }
+   *a_x = _e_place_array_resize(*a_x, a_w, a_alloc_w);
+   (*a_x)[*a_w - 1] = bx;
+   *a_x = _e_place_array_resize(*a_x, a_w, a_alloc_w);
+   (*a_x)[*a_w - 1] = bx + bw;
+   *a_y = _e_place_array_resize(*a_y, a_h, a_alloc_h);
+   (*a_y)[*a_h - 1] = by;
+   *a_y = _e_place_array_resize(*a_y, a_h, a_alloc_h);
+   (*a_y)[*a_h - 1] = by + bh;
 }
 
 /* determine whether the "overlapping" area for a given geometry
@@ -216,11 +272,11 @@ _e_place_desk_region_smart_obstacle_add(char *u_x, char *u_y, int **a_x, int **a
  * geometry to use
  */
 static int
-_e_place_desk_region_smart_area_check(Eina_List *skiplist, int x, int y, int w, int h, E_Desk *desk, int area, int *rx, int *ry)
+_e_place_desk_region_smart_area_check(const E_Place_Coverage *cov, int x, int y, int w, int h, E_Desk *desk, int area, int *rx, int *ry)
 {
    int ar = 0;
 
-   ar = _e_place_coverage_client_add(skiplist, ar, x, y, w, h);
+   ar = _e_place_coverage_client_add(cov, ar, area, x, y, w, h);
 
    if (e_config->window_placement_policy == E_WINDOW_PLACEMENT_SMART)
      ar = _e_place_coverage_zone_obstacles_add(desk, ar, x, y, w, h);
@@ -236,40 +292,40 @@ _e_place_desk_region_smart_area_check(Eina_List *skiplist, int x, int y, int w,
 
 /* calculate optimal placement based on "overlapping" area using:
  * - an obstacle's top-left and bottom-right points
- * - list of clients to skip
+ * - clients which can cover the placement
  * - current desk
  * - current least overlapping area
  * - pointers to current coords to use for placement
  * and then return the new least overlapping area
  */
 static int
-_e_place_desk_region_smart_area_calc(int x, int y, int xx, int yy, int zx, int zy, int zw, int zh, int w, int h, Eina_List *skiplist, E_Desk *desk, int area, int *rx, int *ry)
+_e_place_desk_region_smart_area_calc(int x, int y, int xx, int yy, int zx, int zy, int zw, int zh, int w, int h, const E_Place_Coverage *cov, E_Desk *desk, int area, int *rx, int *ry)
 {
    /* check top-left corner placement */
    if ((x <= MAX(zx, zx + (zw - w))) && (y <= MAX(zy, zy + (zh - h))))
      {
-        int ar = _e_place_desk_region_smart_area_check(skiplist, x, y, w, h, desk, area, rx, ry);
+        int ar = _e_place_desk_region_smart_area_check(cov, x, y, w, h, desk, area, rx, ry);
         if (!ar) return ar;
         if (ar < area) area = ar;
      }
    /* check top-right corner placement */
    if ((MAX(zx, xx - w) > zx) && (y <= MAX(zy, zy + (zh - h))))
      {
-        int ar = _e_place_desk_region_smart_area_check(skiplist, xx - w, y, w, h, desk, area, rx, ry);
+        int ar = _e_place_desk_region_smart_area_check(cov, xx - w, y, w, h, desk, area, rx, ry);
         if (!ar) return ar;
         if (ar < area) area = ar;
      }
    /* check bottom-right corner placement */
    if ((MAX(zx, xx - w) > zx) && (MAX(zy, yy - h) > zy))
      {
-        int ar = _e_place_desk_region_smart_area_check(skiplist, xx - w, yy - h, w, h, desk, area, rx, ry);
+        int ar = _e_place_desk_region_smart_area_check(cov, xx - w, yy - h, w, h, desk, area, rx, ry);
         if (!ar) return ar;
         if (ar < area) area = ar;
      }
    /* check bottom-left corner placement */
    if ((x <= MAX(zx, zx + (zw - w))) && (MAX(zy, yy - h) > zy))
      {
-        int ar = _e_place_desk_region_smart_area_check(skiplist, x, yy - h, w, h, desk, area, rx, ry);
+        int ar = _e_place_desk_region_smart_area_check(cov, x, yy - h, w, h, desk, area, rx, ry);
         if (!ar) return ar;
         if (ar < area) area = ar;
      }
@@ -282,8 +338,8 @@ e_place_desk_region_smart(E_Desk *desk, Eina_List *skiplist, int x, int y, int w
    int a_w = 0, a_h = 0, a_alloc_w = 0, a_alloc_h = 0;
    int *a_x = NULL, *a_y = NULL;
    int zx, zy, zw, zh;
-   char *u_x = NULL, *u_y = NULL;
-   E_Client *ec;
+   E_Place_Coverage cov;
+   int i;
 
    *rx = x;
    *ry = y;
@@ -298,7 +354,6 @@ e_place_desk_region_smart(E_Desk *desk, Eina_List *skiplist, int x, int y, int w
         return 1;
      }
 
-   /* FIXME: this NEEDS optimizing */
    a_w = 2;
    a_h = 2;
    a_x = E_NEW(int, 2);
@@ -311,19 +366,11 @@ e_place_desk_region_smart(E_Desk *desk, Eina_List *skiplist, int x, int y, int w
    zw = desk->zone->w;
    zh = desk->zone->h;
 
-   u_x = calloc(zx + zw + 1, sizeof(char));
-   u_y = calloc(zy + zh + 1, sizeof(char));
-
    a_x[0] = zx;
    a_x[1] = zx + zw;
    a_y[0] = zy;
    a_y[1] = zy + zh;
 
-   u_x[zx] = 1;
-   u_x[zx + zw] = 1;
-   u_y[zy] = 1;
-   u_y[zy + zh] = 1;
-
    if (e_config->window_placement_policy == E_WINDOW_PLACEMENT_SMART)
      {
         E_Zone_Obstacle *obs;
@@ -337,7 +384,7 @@ e_place_desk_region_smart(E_Desk *desk, Eina_List *skiplist, int x, int y, int w
              bw = obs->w;
              bh = obs->h;
              if (E_INTERSECTS(bx, by, bw, bh, zx, zy, zw, zh))
-               _e_place_desk_region_smart_obstacle_add(u_x, u_y, &a_x, &a_y,
+               _e_place_desk_region_smart_obstacle_add(&a_x, &a_y,
                  &a_w, &a_h, &a_alloc_w, &a_alloc_h, zx, zy, zw, zh, bx, by, bw, bh);
           }
         EINA_INLIST_FOREACH(desk->zone->obstacles, obs)
@@ -349,34 +396,25 @@ e_place_desk_region_smart(E_Desk *desk, Eina_List *skiplist, int x, int y, int w
              bw = obs->w;
              bh = obs->h;
              if (E_INTERSECTS(bx, by, bw, bh, zx, zy, zw, zh))
-               _e_place_desk_region_smart_obstacle_add(u_x, u_y, &a_x, &a_y,
+               _e_place_desk_region_smart_obstacle_add(&a_x, &a_y,
                  &a_w, &a_h, &a_alloc_w, &a_alloc_h, zx, zy, zw, zh, bx, by, bw, bh);
           }
      }
 
-   E_CLIENT_REVERSE_FOREACH(ec)
+   _e_place_coverage_init(&cov, skiplist);
+   for (i = 0; i < cov.num; i++)
      {
-        int bx, by, bw, bh;
-
-        if (ignore_client(ec, skiplist)) continue;
-        if (ignore_client_and_break(ec)) break;
-
-        bx = ec->x;
-        by = ec->y;
-        bw = ec->w;
-        bh = ec->h;
+        const Eina_Rectangle *r = &cov.rects[i];
 
-        if (E_INTERSECTS(bx, by, bw, bh, zx, zy, zw, zh))
-          _e_place_desk_region_smart_obstacle_add(u_x, u_y, &a_x, &a_y,
-            &a_w, &a_h, &a_alloc_w, &a_alloc_h, zx, zy, zw, zh, bx, by, bw, bh);
+        if (E_INTERSECTS(r->x, r->y, r->w, r->h, zx, zy, zw, zh))
+          _e_place_desk_region_smart_obstacle_add(&a_x, &a_y,
+            &a_w, &a_h, &a_alloc_w, &a_alloc_h, zx, zy, zw, zh, r->x, r->y, r->w, r->h);
      }
-   qsort(a_x, a_w, sizeof(int), _e_place_cb_sort_cmp);
-   qsort(a_y, a_h, sizeof(int), _e_place_cb_sort_cmp);
-   free(u_x);
-   free(u_y);
+   a_w = _e_place_array_uniq(a_x, a_w);
+   a_h = _e_place_array_uniq(a_y, a_h);
 
    {
-      int i, j;
+      int j;
       int area = 0x7fffffff;
 
       if ((x <= zx + (zw - w)) &&
@@ -384,7 +422,7 @@ e_place_desk_region_smart(E_Desk *desk, Eina_List *skiplist, int x, int y, int w
         {
            int ar = 0;
 
-           ar = _e_place_coverage_client_add(skiplist, ar,
+           ar = _e_place_coverage_client_add(&cov, ar, area,
                                              x, y,
                                              w, h);
 
@@ -410,13 +448,14 @@ e_place_desk_region_smart(E_Desk *desk, Eina_List *skiplist, int x, int y, int w
         for (i = 0; i < a_w - 1; i++)
           {
              area = _e_place_desk_region_smart_area_calc(a_x[i], a_y[j], a_x[i + 1], a_y[j + 1],
-                                                         zx, zy, zw, zh, w, h, skiplist, desk, area, rx, ry);
+                                                         zx, zy, zw, zh, w, h, &cov, desk, area, rx, ry);
              if (!area) goto done;
           }
    }
 done:
    E_FREE(a_x);
    E_FREE(a_y);
+   free(cov.rects);
 
    e_zone_desk_useful_geometry_get(desk->zone, desk, &zx, &zy, &zw, &zh);
 
@@ -13,6 +13,22 @@ struct _E_Remember_List
    Eina_List *list;
 };
 
+typedef struct _E_Remember_Index E_Remember_Index;
+
+/* rules in e_config->remembers keyed by their exact class (or exact name
+ * when the class is a glob), so a lookup only has to glob match the rules
+ * that can possibly apply. positions are list indexes, kept in list order */
+struct _E_Remember_Index
+{
+   Eina_Hash    *classes; /* class -> Eina_Inarray of unsigned int */
+   Eina_Hash    *names; /* name -> Eina_Inarray of unsigned int */
+   Eina_Inarray *globs; /* everything that can't be keyed */
+   E_Remember  **rules;
+   unsigned int  count;
+   unsigned int  generation; /* of e_config the index was built from */
+   Eina_Bool     dirty : 1;
+};
+
 /* local subsystem functions */
 static void        _e_remember_free(E_Remember *rem);
 static void        _e_remember_update(E_Client *ec, E_Remember *rem);
@@ -21,6 +37,7 @@ static void        _e_remember_cb_hook_pre_post_fetch(void *data, E_Client *ec);
 static void        _e_remember_cb_hook_eval_post_new_client(void *data, E_Client *ec);
 static void        _e_remember_init_edd(void);
 static Eina_Bool   _e_remember_restore_cb(void *data, int type, void *event);
+static void        _e_remember_index_free(void);
 
 /* local subsystem globals */
 static Eina_List *hooks = NULL;
@@ -29,6 +46,7 @@ static E_Remember_List *remembers = NULL;
 static Eina_List *handlers = NULL;
 static Ecore_Idler *remember_idler = NULL;
 static Eina_List *remember_idler_list = NULL;
+static E_Remember_Index remember_index = { .dirty = EINA_TRUE };
 
 /* static Eina_List *e_remember_restart_list = NULL; */
 
@@ -62,6 +80,7 @@ e_remember_init(E_Startup_Mode mode)
                }
           }
      }
+   remember_index.dirty = EINA_TRUE;
    E_EVENT_REMEMBER_UPDATE = ecore_event_type_new();
 
    h = e_client_hook_add(E_CLIENT_HOOK_EVAL_PRE_POST_FETCH,
@@ -101,6 +120,7 @@ e_remember_shutdown(void)
    if (remember_idler) ecore_idler_del(remember_idler);
    remember_idler = NULL;
    remember_idler_list = eina_list_free(remember_idler_list);
+   _e_remember_index_free();
 
    return 1;
 }
@@ -227,6 +247,7 @@ e_remember_new(void)
    rem = E_NEW(E_Remember, 1);
    if (!rem) return NULL;
    e_config->remembers = eina_list_prepend(e_config->remembers, rem);
+   remember_index.dirty = EINA_TRUE;
    return rem;
 }
 
@@ -612,6 +633,12 @@ e_remember_sr_find(E_Client *ec)
    return _e_remember_find(ec, 1, 1);
 }
 
+E_API void
+e_remember_rules_changed(void)
+{
+   remember_index.dirty = EINA_TRUE;
+}
+
 E_API void
 e_remember_match_update(E_Remember *rem)
 {
@@ -625,6 +652,7 @@ e_remember_match_update(E_Remember *rem)
    if (rem->match & E_REMEMBER_MATCH_TRANSIENT) max_count += 2;
    if (rem->apply_first_only) max_count++;
 
+   remember_index.dirty = EINA_TRUE;
    if (max_count != rem->max_score)
      {
         /* The number of matches for this remember has changed so we
@@ -695,6 +723,7 @@ e_remember_default_match_set(E_Remember *rem, E_Client *ec)
      }
 
    rem->match = match;
+   remember_index.dirty = EINA_TRUE;
 
    return match;
 }
@@ -848,6 +877,108 @@ _e_remember_update(E_Client *ec, E_Remember *rem)
 }
 
 /* local subsystem functions */
+static Eina_Bool
+_e_remember_match(E_Remember *rem, E_Client *ec)
+{
+   const char *title = "";
+
+   if (ec->netwm.name) title = ec->netwm.name;
+   else title = ec->icccm.title;
+
+   /* For each type of match, check whether the match is
+    * required, and if it is, check whether there's a match. If
+    * it fails, then go to the next remember */
+   if (rem->match & E_REMEMBER_MATCH_NAME &&
+       !e_util_glob_match(ec->icccm.name, rem->name))
+     return EINA_FALSE;
+   if (rem->match & E_REMEMBER_MATCH_CLASS &&
+       !e_util_glob_match(ec->icccm.class, rem->class))
+     return EINA_FALSE;
+   if (rem->match & E_REMEMBER_MATCH_TITLE &&
+       !e_util_glob_match(title, rem->title))
+     return EINA_FALSE;
+   if (rem->match & E_REMEMBER_MATCH_ROLE &&
+       e_util_strcmp(rem->role, ec->icccm.window_role) &&
+       !e_util_both_str_empty(rem->role, ec->icccm.window_role))
+     return EINA_FALSE;
+   if (rem->match & E_REMEMBER_MATCH_TYPE &&
+       rem->type != (int)ec->netwm.type)
+     return EINA_FALSE;
+   if (rem->match & E_REMEMBER_MATCH_TRANSIENT &&
+       !(rem->transient && ec->icccm.transient_for != 0) &&
+       !(!rem->transient) && (ec->icccm.transient_for == 0))
+     return EINA_FALSE;
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_e_remember_pattern_exact(const char *pattern)
+{
+   /* e_util_glob_match() is a plain strcmp for these */
+   return pattern && (!strpbrk(pattern, "*?[\\"));
+}
+
+static void
+_e_remember_index_add(Eina_Hash *hash, const char *key, unsigned int pos)
+{
+   Eina_Inarray *arr;
+
+   arr = eina_hash_find(hash, key);
+   if (!arr)
+     {
+        arr = eina_inarray_new(sizeof(unsigned int), 4);
+        eina_hash_add(hash, key, arr);
+     }
+   eina_inarray_push(arr, &pos);
+}
+
+static void
+_e_remember_index_free(void)
+{
+   E_FREE_FUNC(remember_index.classes, eina_hash_free);
+   E_FREE_FUNC(remember_index.names, eina_hash_free);
+   E_FREE_FUNC(remember_index.globs, eina_inarray_free);
+   E_FREE(remember_index.rules);
+   remember_index.count = 0;
+   remember_index.dirty = EINA_TRUE;
+}
+
+static void
+_e_remember_index_update(void)
+{
+   Eina_List *l;
+   E_Remember *rem;
+   unsigned int pos = 0;
+
+   /* the config list can also be swapped out from under us on reload */
+   if ((!remember_index.dirty) &&
+       (remember_index.generation == e_config_generation_get()))
+     return;
+
+   _e_remember_index_free();
+   remember_index.generation = e_config_generation_get();
+   remember_index.count = eina_list_count(e_config->remembers);
+   remember_index.rules = E_NEW(E_Remember *, remember_index.count + 1);
+   remember_index.classes = eina_hash_string_superfast_new(EINA_FREE_CB(eina_inarray_free));
+   remember_index.names = eina_hash_string_superfast_new(EINA_FREE_CB(eina_inarray_free));
+   remember_index.globs = eina_inarray_new(sizeof(unsigned int), 8);
+   EINA_LIST_FOREACH(e_config->remembers, l, rem)
+     {
+        remember_index.rules[pos] = rem;
+        if ((rem->match & E_REMEMBER_MATCH_CLASS) &&
+            _e_remember_pattern_exact(rem->class))
+          _e_remember_index_add(remember_index.classes, rem->class, pos);
+        else if ((rem->match & E_REMEMBER_MATCH_NAME) &&
+                 _e_remember_pattern_exact(rem->name))
+          _e_remember_index_add(remember_index.names, rem->name, pos);
+        else
+          eina_inarray_push(remember_index.globs, &pos);
+        pos++;
+     }
+   remember_index.dirty = EINA_FALSE;
+}
+
 static E_Remember *
 _e_remember_find(E_Client *ec, int check_usable, Eina_Bool sr)
 {
@@ -907,52 +1038,62 @@ _e_remember_find(E_Client *ec, int check_usable, Eina_Bool sr)
     * with the most possible matches at the start of the list. This
     * means, as soon as a valid match is found, it is a match
     * within the set of best possible matches. */
-   EINA_LIST_FOREACH(e_config->remembers, l, rem)
+   if (sr)
      {
-        const char *title = "";
-
-        if ((check_usable) && (!e_remember_usable_get(rem)))
-          continue;
-
-        if (sr)
+        EINA_LIST_FOREACH(e_config->remembers, l, rem)
           {
+             if ((check_usable) && (!e_remember_usable_get(rem)))
+               continue;
              if (!eina_streq(rem->uuid, ec->uuid)) continue;
              if (rem->uuid)
                {
                   if (rem->pid != ec->netwm.pid) continue;
                   return rem;
                }
+             if (_e_remember_match(rem, ec)) return rem;
           }
-        else if (rem->apply & E_REMEMBER_APPLY_UUID) continue;
+        return NULL;
+     }
+   else
+     {
+        Eina_Inarray *cands[3] = { NULL, NULL, NULL };
+        unsigned int idx[3] = { 0, 0, 0 };
+
+        _e_remember_index_update();
+        if (ec->icccm.class)
+          cands[0] = eina_hash_find(remember_index.classes, ec->icccm.class);
+        if (ec->icccm.name)
+          cands[1] = eina_hash_find(remember_index.names, ec->icccm.name);
+        cands[2] = remember_index.globs;
+
+        /* walk the candidate sets merged back into list order so the
+         * first match is the same rule a full list walk would find */
+        for (;;)
+          {
+             unsigned int i, best = 0, pos = UINT_MAX;
 
-        if (ec->netwm.name) title = ec->netwm.name;
-        else title = ec->icccm.title;
+             for (i = 0; i < 3; i++)
+               {
+                  unsigned int *p;
 
-        /* For each type of match, check whether the match is
-         * required, and if it is, check whether there's a match. If
-         * it fails, then go to the next remember */
-        if (rem->match & E_REMEMBER_MATCH_NAME &&
-            !e_util_glob_match(ec->icccm.name, rem->name))
-          continue;
-        if (rem->match & E_REMEMBER_MATCH_CLASS &&
-            !e_util_glob_match(ec->icccm.class, rem->class))
-          continue;
-        if (rem->match & E_REMEMBER_MATCH_TITLE &&
-            !e_util_glob_match(title, rem->title))
-          continue;
-        if (rem->match & E_REMEMBER_MATCH_ROLE &&
-            e_util_strcmp(rem->role, ec->icccm.window_role) &&
-            !e_util_both_str_empty(rem->role, ec->icccm.window_role))
-          continue;
-        if (rem->match & E_REMEMBER_MATCH_TYPE &&
-            rem->type != (int)ec->netwm.type)
-          continue;
-        if (rem->match & E_REMEMBER_MATCH_TRANSIENT &&
-            !(rem->transient && ec->icccm.transient_for != 0) &&
-            !(!rem->transient) && (ec->icccm.transient_for == 0))
-          continue;
-
-        return rem;
+                  if ((!cands[i]) || (idx[i] >= eina_inarray_count(cands[i])))
+                    continue;
+                  p = eina_inarray_nth(cands[i], idx[i]);
+                  if (*p < pos)
+                    {
+                       pos = *p;
+                       best = i;
+                    }
+               }
+             if (pos == UINT_MAX) break;
+             idx[best]++;
+
+             rem = remember_index.rules[pos];
+             if ((check_usable) && (!e_remember_usable_get(rem)))
+               continue;
+             if (rem->apply & E_REMEMBER_APPLY_UUID) continue;
+             if (_e_remember_match(rem, ec)) return rem;
+          }
      }
 
    return NULL;
@@ -963,6 +1104,7 @@ static void
 _e_remember_free(E_Remember *rem)
 {
    e_config->remembers = eina_list_remove(e_config->remembers, rem);
+   remember_index.dirty = EINA_TRUE;
    if (rem->name) eina_stringshare_del(rem->name);
    if (rem->class) eina_stringshare_del(rem->class);
    if (rem->title) eina_stringshare_del(rem->title);
@@ -133,6 +133,8 @@ E_API E_Remember *e_remember_find(E_Client *ec);
 E_API E_Remember *e_remember_find_usable(E_Client *ec);
 E_API E_Remember *e_remember_sr_find(E_Client *ec);
 E_API void        e_remember_match_update(E_Remember *rem);
+/* call after changing the name/class/match of an existing rule directly */
+E_API void        e_remember_rules_changed(void);
 E_API void        e_remember_update(E_Client *ec);
 E_API int         e_remember_default_match_set(E_Remember *rem, E_Client *ec);
 E_API void        e_remember_internal_save(void);
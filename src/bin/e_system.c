@@ -17,6 +17,10 @@ static Ecore_Exe *_system_exe = NULL;
 static Ecore_Event_Handler *_handler_del = NULL;
 static Ecore_Event_Handler *_handler_data = NULL;
 static Eina_Binbuf *_msg_buf = NULL;
+static size_t _msg_pos = 0; // bytes of _msg_buf already parsed
+static E_System_Stats _stats = { 0 };
+static unsigned int _ping_seq = 0;
+static double _ping_time = 0.0;
 static Eina_Hash *_handlers = NULL;
 static int _handlers_busy = 0;
 static Ecore_Timer *_error_dialog_timer = NULL;
@@ -137,22 +141,44 @@ _system_spawn(void)
      (buf, ECORE_EXE_NOT_LEADER | ECORE_EXE_TERM_WITH_PARENT |
       ECORE_EXE_PIPE_READ | ECORE_EXE_PIPE_WRITE, NULL);
    if (!_system_exe) _system_spawn_error(0);
+   else if (_stats.start <= 0.0) _stats.start = t;
 }
 
+static void
+_msg_buf_reset(void)
+{
+   if (_msg_buf) eina_binbuf_free(_msg_buf);
+   _msg_buf = eina_binbuf_new();
+   _msg_pos = 0;
+}
+
+// messages are parsed where they sit in _msg_buf; consumed bytes are only
+// dropped once per read in _cb_exe_data() so a burst costs one move, not one
+// copy of the remaining buffer per message
 static Eina_Bool
 _system_message_read(void)
 {
-   Message_Head *head;
-   const void *bdata = eina_binbuf_string_get(_msg_buf);
-   const char *data = bdata;
+   Message_Head head;
+   const char *data = (const char *)eina_binbuf_string_get(_msg_buf);
    size_t len = eina_binbuf_length_get(_msg_buf);
-   Eina_Binbuf *buf2;
 
    if (!data) return EINA_FALSE;
-   if (len < sizeof(Message_Head)) return EINA_FALSE;
-   head = (Message_Head *)bdata;
-   head->cmd[23] = 0;
-   if (len < (sizeof(Message_Head) + head->size)) return EINA_FALSE;
+   if (len - _msg_pos < sizeof(Message_Head)) return EINA_FALSE;
+   data += _msg_pos;
+   len -= _msg_pos;
+   // the head may be unaligned in the middle of the buffer
+   memcpy(&head, data, sizeof(Message_Head));
+   head.cmd[23] = 0;
+   if (head.size < 0)
+     {
+        ERR("Invalid message payload size %i from system process", head.size);
+        _msg_pos = eina_binbuf_length_get(_msg_buf);
+        return EINA_FALSE;
+     }
+   if (len < (sizeof(Message_Head) + head.size)) return EINA_FALSE;
+   _msg_pos += sizeof(Message_Head) + head.size;
+   _stats.msgs_recv++;
+   _stats.bytes_recv += sizeof(Message_Head) + head.size;
    if (_handlers)
      {
         Eina_List *list, *l, *ll, *plist;
@@ -160,15 +186,15 @@ _system_message_read(void)
         int del_count = 0;
 
         _handlers_busy++;
-        list = plist = eina_hash_find(_handlers, head->cmd);
+        list = plist = eina_hash_find(_handlers, head.cmd);
         EINA_LIST_FOREACH(list, l, h)
           {
              if (!h->delete_me)
                {
-                  if (head->size == 0) h->func(h->data, NULL);
+                  if (head.size == 0) h->func(h->data, NULL);
                   else
                     {
-                       if ((data + sizeof(Message_Head))[head->size - 1] == 0)
+                       if ((data + sizeof(Message_Head))[head.size - 1] == 0)
                          h->func(h->data,
                                  (const char *)(data + sizeof(Message_Head)));
                     }
@@ -189,21 +215,11 @@ _system_message_read(void)
           }
         if (del_count > 0)
           {
-             eina_hash_del(_handlers, head->cmd, plist);
+             eina_hash_del(_handlers, head.cmd, plist);
              if (list)
-               eina_hash_add(_handlers, head->cmd, list);
+               eina_hash_add(_handlers, head.cmd, list);
           }
      }
-   buf2 = eina_binbuf_new();
-   if (buf2)
-     {
-        eina_binbuf_append_length
-          (buf2,
-           (const unsigned char *)data + sizeof(Message_Head) + head->size,
-           len - (sizeof(Message_Head) + head->size));
-        eina_binbuf_free(_msg_buf);
-        _msg_buf = buf2;
-     }
    return EINA_TRUE;
 }
 
@@ -235,8 +251,7 @@ _cb_exe_del(void *data EINA_UNUSED, int ev_type EINA_UNUSED, void *event)
    else
      {
         // it died for some other reason - restart it - maybe crashed?
-        if (_msg_buf) eina_binbuf_free(_msg_buf);
-        _msg_buf = eina_binbuf_new();
+        _msg_buf_reset();
         _system_spawn();
      }
    return ECORE_CALLBACK_DONE;
@@ -252,12 +267,40 @@ _cb_exe_data(void *data EINA_UNUSED, int ev_type EINA_UNUSED, void *event)
    // i/o channel to/from the child exe stdin/out
    if (_msg_buf)
      {
+        Eina_Binbuf *buf = _msg_buf;
+
         eina_binbuf_append_length(_msg_buf, ev->data, ev->size);
-        while (_msg_buf && _system_message_read());
+        while ((_msg_buf == buf) && _system_message_read());
+        // a handler may have replaced the buffer (restart/shutdown)
+        if ((_msg_buf == buf) && (_msg_pos > 0))
+          {
+             if (_msg_pos >= eina_binbuf_length_get(_msg_buf))
+               eina_binbuf_reset(_msg_buf);
+             else
+               eina_binbuf_remove(_msg_buf, 0, _msg_pos);
+             _msg_pos = 0;
+          }
      }
    return ECORE_CALLBACK_DONE;
 }
 
+static void
+_cb_pong(void *data EINA_UNUSED, const char *params)
+{
+   unsigned int seq;
+   double rtt;
+
+   if ((!params) || (sscanf(params, "%u", &seq) != 1)) return;
+   if ((seq != _ping_seq) || (_ping_time <= 0.0)) return;
+   rtt = ecore_time_get() - _ping_time;
+   _ping_time = 0.0;
+   if ((!_stats.pings) || (rtt < _stats.rtt_min)) _stats.rtt_min = rtt;
+   if (rtt > _stats.rtt_max) _stats.rtt_max = rtt;
+   _stats.rtt_last = rtt;
+   _stats.rtt_total += rtt;
+   _stats.pings++;
+}
+
 static Eina_Bool
 _handler_list_free(const Eina_Hash *hash EINA_UNUSED, const void *key EINA_UNUSED, void *data, void *fdata EINA_UNUSED)
 {
@@ -278,8 +321,9 @@ e_system_init(void)
    //   ... per message - call registered cb's for that msg
    _handler_del = ecore_event_handler_add(ECORE_EXE_EVENT_DEL, _cb_exe_del, NULL);
    _handler_data = ecore_event_handler_add(ECORE_EXE_EVENT_DATA, _cb_exe_data, NULL);
-   _msg_buf = eina_binbuf_new();
+   _msg_buf_reset();
    _handlers = eina_hash_string_superfast_new(NULL);
+   e_system_handler_add("pong", _cb_pong, NULL);
    _system_spawn();
    return 1;
 }
@@ -305,6 +349,7 @@ e_system_shutdown(void)
      }
    if (_error_dialog_timer) ecore_timer_del(_error_dialog_timer);
    _msg_buf = NULL;
+   _msg_pos = 0;
    _handler_del = NULL;
    _handler_data = NULL;
    _system_exe = NULL;
@@ -316,7 +361,9 @@ e_system_shutdown(void)
 E_API void EINA_PRINTF(2, 3)
 e_system_send(const char *cmd, const char *fmt, ...)
 {
-   char *buf = NULL, stack_buf[4096];
+   // head and payload are built in one buffer so each message is a single
+   // send and a single append to the exe's write buffer
+   char *msg = NULL, stack_buf[sizeof(Message_Head) + 4096];
    Message_Head head;
    size_t len = strlen(cmd);
    int printed = 0;
@@ -332,18 +379,19 @@ e_system_send(const char *cmd, const char *fmt, ...)
         ERR("Trying to send command of length %i (max 23)", (int)len);
         return;
      }
+   msg = stack_buf;
    if (fmt)
      {
-        buf = stack_buf;
         va_start(ap, fmt);
-        printed = vsnprintf(stack_buf, sizeof(stack_buf), fmt, ap);
+        printed = vsnprintf(stack_buf + sizeof(Message_Head),
+                            sizeof(stack_buf) - sizeof(Message_Head), fmt, ap);
         va_end(ap);
-        if ((size_t)printed >= (sizeof(stack_buf) - 1))
+        if ((size_t)printed >= (sizeof(stack_buf) - sizeof(Message_Head) - 1))
           {
-             buf = malloc(printed + 1);
-             if (!buf) goto end;
+             msg = malloc(sizeof(Message_Head) + printed + 1);
+             if (!msg) goto end;
              va_start(ap, fmt);
-             printed = vsnprintf(buf, printed + 1, fmt, ap);
+             printed = vsnprintf(msg + sizeof(Message_Head), printed + 1, fmt, ap);
              va_end(ap);
           }
      }
@@ -352,13 +400,30 @@ e_system_send(const char *cmd, const char *fmt, ...)
    memcpy(head.cmd, cmd, len);
    if (printed > 0) head.size = printed + 1;
    else head.size = 0;
-   ecore_exe_send(_system_exe, &head, sizeof(head));
-   if ((buf) && (head.size > 0))
-     {
-        ecore_exe_send(_system_exe, buf, head.size);
-     }
+   memcpy(msg, &head, sizeof(head));
+   ecore_exe_send(_system_exe, msg, sizeof(head) + head.size);
+   _stats.msgs_sent++;
+   _stats.bytes_sent += sizeof(head) + head.size;
 end:
-   if (buf != stack_buf) free(buf);
+   if (msg != stack_buf) free(msg);
+}
+
+/* measure a round trip to enlightenment_system; the result lands in
+ * e_system_stats_get() once the reply arrives
+ */
+E_API void
+e_system_ping(void)
+{
+   if (!_system_exe) return;
+   _ping_seq++;
+   _ping_time = ecore_time_get();
+   e_system_send("ping", "%u", _ping_seq);
+}
+
+E_API const E_System_Stats *
+e_system_stats_get(void)
+{
+   return &_stats;
 }
 
 E_API void
@@ -1,15 +1,33 @@
 #ifdef E_TYPEDEFS
 
+typedef struct _E_System_Stats E_System_Stats;
+
 #else
 #ifndef E_SYSTEM_H
 #define E_SYSTEM_H
 
+struct _E_System_Stats
+{
+   double             start; // time enlightenment_system was first spawned
+   unsigned long long msgs_sent; // messages sent to enlightenment_system
+   unsigned long long msgs_recv; // messages received from enlightenment_system
+   unsigned long long bytes_sent;
+   unsigned long long bytes_recv;
+   unsigned int       pings; // round trips measured by e_system_ping()
+   double             rtt_last;
+   double             rtt_min;
+   double             rtt_max;
+   double             rtt_total;
+};
+
 EINTERN int e_system_init(void);
 EINTERN int e_system_shutdown(void);
 
 E_API void e_system_send(const char *cmd, const char *fmt, ...) EINA_PRINTF(2, 3);
 E_API void e_system_handler_add(const char *cmd, void (*func) (void *data, const char *params), void *data);
 E_API void e_system_handler_del(const char *cmd, void (*func) (void *data, const char *params), void *data);
+E_API void e_system_ping(void);
+E_API const E_System_Stats *e_system_stats_get(void);
 
 #endif
 #endif
@@ -18,6 +18,47 @@ struct _E_Thumb
    unsigned char done E_BITFIELD;
 };
 
+/* thumbs that are known to be fresh are indexed per source directory so a
+ * whole listing can be resolved from one small eet file instead of asking
+ * the thumbnailer (and it stat'ing and opening every .thm) file by file */
+typedef struct _E_Thumb_Cache_Entry E_Thumb_Cache_Entry;
+typedef struct _E_Thumb_Cache_Dir E_Thumb_Cache_Dir;
+typedef struct _E_Thumb_Cache_Lru E_Thumb_Cache_Lru;
+typedef struct _E_Thumb_Cache_Lru_Dir E_Thumb_Cache_Lru_Dir;
+
+struct _E_Thumb_Cache_Entry
+{
+   const char  *thumb;
+   const char  *sort_id;
+   long long    mtime, size; /* of the source when the thumb was made */
+   unsigned int bytes; /* of the thumb itself */
+};
+
+struct _E_Thumb_Cache_Dir
+{
+   Eina_Hash    *entries;
+   /* not saved */
+   const char   *id;
+   double        used;
+   unsigned char dirty E_BITFIELD;
+};
+
+struct _E_Thumb_Cache_Lru_Dir
+{
+   double    used;
+   long long bytes;
+};
+
+struct _E_Thumb_Cache_Lru
+{
+   Eina_Hash *dirs;
+};
+
+#define E_THUMB_CACHE_MAX    (512LL * 1024LL * 1024LL)
+#define E_THUMB_CACHE_IDLE   60.0
+#define E_THUMB_CACHE_FLUSH  5.0
+#define E_THUMB_CACHE_MISSING_MAX 4096
+
 /* local subsystem functions */
 static void         _e_thumb_gen_begin(int objid, const char *file, const char *key, int w, int h, int desk_x, int desk_y, int desk_x_count, int desk_y_count, Eina_List *sigsrc);
 static void         _e_thumb_gen_end(int objid);
@@ -29,6 +70,13 @@ static void         _e_thumb_thumbnailers_kill(void);
 static void         _e_thumb_thumbnailers_kill_cancel(void);
 static Eina_Bool    _e_thumb_cb_kill(void *data);
 static Eina_Bool    _e_thumb_cb_exe_event_del(void *data, int type, void *event);
+static void         _e_thumb_icon_set(Evas_Object *obj, E_Thumb *eth, const char *icon);
+static void         _e_thumb_cache_init(void);
+static void         _e_thumb_cache_shutdown(void);
+static E_Thumb_Cache_Entry *_e_thumb_cache_find(E_Thumb *eth);
+static void         _e_thumb_cache_add(E_Thumb *eth, const char *icon);
+static void         _e_thumb_cache_del(E_Thumb *eth);
+static void         _e_thumb_cache_flush_queue(void);
 
 /* local subsystem globals */
 static Eina_List *_thumbnailers = NULL;
@@ -40,6 +88,15 @@ static int _pending = 0;
 static int _num_thumbnailers = 1;
 static Ecore_Event_Handler *_exe_del_handler = NULL;
 static Ecore_Timer *_kill_timer = NULL;
+static Eet_Data_Descriptor *_cache_entry_edd = NULL;
+static Eet_Data_Descriptor *_cache_dir_edd = NULL;
+static Eet_Data_Descriptor *_cache_lru_dir_edd = NULL;
+static Eet_Data_Descriptor *_cache_lru_edd = NULL;
+static Eina_Hash *_cache_dirs = NULL;
+static Eina_Hash *_cache_dirs_missing = NULL; // source dirs known to have no index
+static Ecore_Timer *_cache_flush_timer = NULL;
+static Eina_Bool _cache_lru_dirty = EINA_FALSE;
+static char _cache_path[PATH_MAX] = "";
 
 /* externally accessible functions */
 EINTERN int
@@ -49,6 +106,7 @@ e_thumb_init(void)
                                               _e_thumb_cb_exe_event_del,
                                               NULL);
    _thumbs = eina_hash_string_superfast_new(NULL);
+   _e_thumb_cache_init();
    return 1;
 }
 
@@ -57,6 +115,7 @@ e_thumb_shutdown(void)
 {
    _e_thumb_thumbnailers_kill_cancel();
    _e_thumb_cb_kill(NULL);
+   _e_thumb_cache_shutdown();
    if (_exe_del_handler) ecore_event_handler_del(_exe_del_handler);
    _exe_del_handler = NULL;
    _thumbnailers = eina_list_free(_thumbnailers);
@@ -123,6 +182,7 @@ E_API void
 e_thumb_icon_begin(Evas_Object *obj)
 {
    E_Thumb *eth, *eth2;
+   E_Thumb_Cache_Entry *ce;
    char buf[4096];
 
    eth = evas_object_data_get(obj, "e_thumbdata");
@@ -131,6 +191,17 @@ e_thumb_icon_begin(Evas_Object *obj)
    if (eth->busy) return;
    if (eth->done) return;
    if (!eth->file) return;
+   ce = _e_thumb_cache_find(eth);
+   if (ce)
+     {
+        eth->done = 1;
+        free(eth->sort_id);
+        eth->sort_id = ce->sort_id ? strdup(ce->sort_id) : NULL;
+        e_icon_preload_set(obj, 1);
+        e_icon_file_key_set(obj, ce->thumb, "/thumbnail/data");
+        evas_object_smart_callback_call(obj, "e_thumb_gen", NULL);
+        return;
+     }
    if (!_thumbnailers)
      {
         while ((int)eina_list_count(_thumbnailers_exe) < _num_thumbnailers)
@@ -196,6 +267,7 @@ e_thumb_icon_rethumb(Evas_Object *obj)
    eth = evas_object_data_get(obj, "e_thumbdata");
    if (!eth) return;
 
+   _e_thumb_cache_del(eth);
    if (eth->done) eth->done = 0;
    else e_thumb_icon_end(obj);
 
@@ -252,6 +324,19 @@ _e_thumb_key_load(E_Thumb *eth, const char *icon)
    eet_close(ef);
 }
 
+static void
+_e_thumb_icon_set(Evas_Object *obj, E_Thumb *eth, const char *icon)
+{
+   if (ecore_file_exists(icon))
+     {
+        e_icon_preload_set(obj, 1);
+        e_icon_file_key_set(obj, icon, "/thumbnail/data");
+        _e_thumb_key_load(eth, icon);
+        _e_thumb_cache_add(eth, icon);
+     }
+   evas_object_smart_callback_call(obj, "e_thumb_gen", NULL);
+}
+
 E_API const char *
 e_thumb_sort_id_get(Evas_Object *obj)
 {
@@ -288,13 +373,7 @@ e_thumb_client_data(Ecore_Ipc_Event_Client_Data *e)
                        _pending--;
                        eth->done = 1;
                        if (_pending == 0) _e_thumb_thumbnailers_kill();
-                       if (ecore_file_exists(icon))
-                         {
-                            e_icon_preload_set(obj, 1);
-                            e_icon_file_key_set(obj, icon, "/thumbnail/data");
-                            _e_thumb_key_load(eth, icon);
-                         }
-                       evas_object_smart_callback_call(obj, "e_thumb_gen", NULL);
+                       _e_thumb_icon_set(obj, eth, icon);
                     }
                }
           }
@@ -523,3 +602,477 @@ _e_thumb_cb_exe_event_del(void *data EINA_UNUSED, int type EINA_UNUSED, void *ev
    return ECORE_CALLBACK_PASS_ON;
 }
 
+
+static Eina_Bool
+_e_thumb_cache_entry_free_cb(const Eina_Hash *hash EINA_UNUSED, const void *key EINA_UNUSED, void *data, void *fdata EINA_UNUSED)
+{
+   E_Thumb_Cache_Entry *ce = data;
+
+   eina_stringshare_del(ce->thumb);
+   eina_stringshare_del(ce->sort_id);
+   free(ce);
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_e_thumb_cache_lru_dir_free_cb(const Eina_Hash *hash EINA_UNUSED, const void *key EINA_UNUSED, void *data, void *fdata EINA_UNUSED)
+{
+   free(data);
+   return EINA_TRUE;
+}
+
+static void
+_e_thumb_cache_dir_free(E_Thumb_Cache_Dir *cd)
+{
+   if (!cd) return;
+   if (cd->entries)
+     {
+        eina_hash_foreach(cd->entries, _e_thumb_cache_entry_free_cb, NULL);
+        eina_hash_free(cd->entries);
+     }
+   eina_stringshare_del(cd->id);
+   free(cd);
+}
+
+static void
+_e_thumb_cache_lru_free(E_Thumb_Cache_Lru *lru)
+{
+   if (!lru) return;
+   if (lru->dirs)
+     {
+        eina_hash_foreach(lru->dirs, _e_thumb_cache_lru_dir_free_cb, NULL);
+        eina_hash_free(lru->dirs);
+     }
+   free(lru);
+}
+
+static void
+_e_thumb_cache_init(void)
+{
+   Eet_Data_Descriptor_Class eddc;
+
+   e_user_dir_concat_static(_cache_path, "fileman/thumbnails/index");
+   ecore_file_mkpath(_cache_path);
+   _cache_dirs = eina_hash_string_superfast_new(NULL);
+   _cache_dirs_missing = eina_hash_string_superfast_new(NULL);
+
+   if (!eet_eina_stream_data_descriptor_class_set(&eddc, sizeof(eddc), "thumb_cache_entry", sizeof(E_Thumb_Cache_Entry)))
+     return;
+   _cache_entry_edd = eet_data_descriptor_stream_new(&eddc);
+#define DAT(x, y, z) EET_DATA_DESCRIPTOR_ADD_BASIC(_cache_entry_edd, E_Thumb_Cache_Entry, x, y, z)
+   DAT("t", thumb, EET_T_STRING);
+   DAT("s", sort_id, EET_T_STRING);
+   DAT("m", mtime, EET_T_LONG_LONG);
+   DAT("z", size, EET_T_LONG_LONG);
+   DAT("b", bytes, EET_T_UINT);
+#undef DAT
+
+   eddc.size = sizeof(E_Thumb_Cache_Dir);
+   eddc.name = "thumb_cache_dir";
+   _cache_dir_edd = eet_data_descriptor_stream_new(&eddc);
+   EET_DATA_DESCRIPTOR_ADD_HASH(_cache_dir_edd, E_Thumb_Cache_Dir, "e",
+                                entries, _cache_entry_edd);
+
+   eddc.size = sizeof(E_Thumb_Cache_Lru_Dir);
+   eddc.name = "thumb_cache_lru_dir";
+   _cache_lru_dir_edd = eet_data_descriptor_stream_new(&eddc);
+#define DAT(x, y, z) EET_DATA_DESCRIPTOR_ADD_BASIC(_cache_lru_dir_edd, E_Thumb_Cache_Lru_Dir, x, y, z)
+   DAT("u", used, EET_T_DOUBLE);
+   DAT("b", bytes, EET_T_LONG_LONG);
+#undef DAT
+
+   eddc.size = sizeof(E_Thumb_Cache_Lru);
+   eddc.name = "thumb_cache_lru";
+   _cache_lru_edd = eet_data_descriptor_stream_new(&eddc);
+   EET_DATA_DESCRIPTOR_ADD_HASH(_cache_lru_edd, E_Thumb_Cache_Lru, "d",
+                                dirs, _cache_lru_dir_edd);
+}
+
+static char *
+_e_thumb_cache_file_get(const char *id, char *buf, size_t size)
+{
+   snprintf(buf, size, "%s/%s.eet", _cache_path, id);
+   return buf;
+}
+
+static void
+_e_thumb_cache_dir_id(const char *dir, char *id)
+{
+   const char *chmap = "0123456789abcdef";
+   unsigned char sum[20];
+   int i;
+
+   e_sha1_sum((unsigned char *)dir, strlen(dir), sum);
+   for (i = 0; i < 20; i++)
+     {
+        id[(i * 2) + 0] = chmap[(sum[i] >> 4) & 0xf];
+        id[(i * 2) + 1] = chmap[(sum[i]) & 0xf];
+     }
+   id[i * 2] = 0;
+}
+
+static E_Thumb_Cache_Dir *
+_e_thumb_cache_dir_load(const char *id)
+{
+   E_Thumb_Cache_Dir *cd = NULL;
+   Eet_File *ef;
+   char buf[PATH_MAX];
+
+   ef = eet_open(_e_thumb_cache_file_get(id, buf, sizeof(buf)), EET_FILE_MODE_READ);
+   if (ef)
+     {
+        cd = eet_data_read(ef, _cache_dir_edd, "index");
+        eet_close(ef);
+     }
+   return cd;
+}
+
+static E_Thumb_Cache_Dir *
+_e_thumb_cache_dir_get(const char *file, Eina_Bool create)
+{
+   E_Thumb_Cache_Dir *cd;
+   char *dir, id[41];
+
+   if ((!_cache_dirs) || (!_cache_dir_edd)) return NULL;
+   dir = ecore_file_dir_get(file);
+   if (!dir) return NULL;
+   /* lookups in a directory without an index skip the sha1 and eet_open */
+   if ((!create) && (eina_hash_find(_cache_dirs_missing, dir)))
+     {
+        free(dir);
+        return NULL;
+     }
+   _e_thumb_cache_dir_id(dir, id);
+
+   cd = eina_hash_find(_cache_dirs, id);
+   if (!cd)
+     {
+        cd = _e_thumb_cache_dir_load(id);
+        if ((!cd) && (!create))
+          {
+             if (eina_hash_population(_cache_dirs_missing) >= E_THUMB_CACHE_MISSING_MAX)
+               eina_hash_free_buckets(_cache_dirs_missing);
+             eina_hash_add(_cache_dirs_missing, dir, (void *)1);
+             free(dir);
+             return NULL;
+          }
+        if (!cd) cd = E_NEW(E_Thumb_Cache_Dir, 1);
+        if (!cd)
+          {
+             free(dir);
+             return NULL;
+          }
+        if (!cd->entries) cd->entries = eina_hash_string_small_new(NULL);
+        cd->id = eina_stringshare_add(id);
+        eina_hash_add(_cache_dirs, id, cd);
+        eina_hash_del_by_key(_cache_dirs_missing, dir);
+     }
+   free(dir);
+   cd->used = ecore_time_unix_get();
+   _cache_lru_dirty = EINA_TRUE;
+   return cd;
+}
+
+static void
+_e_thumb_cache_key(E_Thumb *eth, char *buf, size_t size)
+{
+   Eina_List *l;
+   const char *s;
+   size_t n;
+
+   n = snprintf(buf, size, "%s|%s|%ix%i", ecore_file_file_get(eth->file),
+                eth->key ? eth->key : "", eth->w, eth->h);
+   EINA_LIST_FOREACH(eth->sigsrc, l, s)
+     {
+        if (n >= size) break;
+        n += snprintf(buf + n, size - n, "|%s", s);
+     }
+}
+
+static E_Thumb_Cache_Entry *
+_e_thumb_cache_find(E_Thumb *eth)
+{
+   E_Thumb_Cache_Dir *cd;
+   E_Thumb_Cache_Entry *ce;
+   struct stat st;
+   char key[PATH_MAX + 256];
+
+   cd = _e_thumb_cache_dir_get(eth->file, EINA_FALSE);
+   if (!cd) return NULL;
+   _e_thumb_cache_key(eth, key, sizeof(key));
+   ce = eina_hash_find(cd->entries, key);
+   if (!ce) return NULL;
+   if (stat(eth->file, &st)) return NULL;
+   if ((ce->mtime != (long long)st.st_mtime) ||
+       (ce->size != (long long)st.st_size))
+     return NULL;
+   /* the thumb may have been removed behind our back */
+   if ((!ce->thumb) || (stat(ce->thumb, &st)))
+     {
+        eina_hash_del_by_key(cd->entries, key);
+        _e_thumb_cache_entry_free_cb(NULL, NULL, ce, NULL);
+        cd->dirty = 1;
+        _e_thumb_cache_flush_queue();
+        return NULL;
+     }
+   return ce;
+}
+
+static Eina_Bool
+_e_thumb_cache_bytes_cb(const Eina_Hash *hash EINA_UNUSED, const void *key EINA_UNUSED, void *data, void *fdata)
+{
+   E_Thumb_Cache_Entry *ce = data;
+   long long *bytes = fdata;
+
+   *bytes += ce->bytes;
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_e_thumb_cache_unlink_list_cb(const Eina_Hash *hash EINA_UNUSED, const void *key EINA_UNUSED, void *data, void *fdata)
+{
+   E_Thumb_Cache_Entry *ce = data;
+   Eina_List **files = fdata;
+
+   if (ce->thumb) *files = eina_list_append(*files, strdup(ce->thumb));
+   return EINA_TRUE;
+}
+
+static void
+_e_thumb_cache_unlink(void *data, Ecore_Thread *th EINA_UNUSED)
+{
+   Eina_List *files = data;
+   Eina_List *l;
+   char *file;
+
+   EINA_LIST_FOREACH(files, l, file) unlink(file);
+}
+
+static void
+_e_thumb_cache_unlink_end(void *data, Ecore_Thread *th EINA_UNUSED)
+{
+   Eina_List *files = data;
+
+   E_FREE_LIST(files, free);
+}
+
+typedef struct
+{
+   const char *id;
+   double      used;
+} E_Thumb_Cache_Oldest;
+
+static Eina_Bool
+_e_thumb_cache_oldest_cb(const Eina_Hash *hash EINA_UNUSED, const void *key, void *data, void *fdata)
+{
+   E_Thumb_Cache_Lru_Dir *ld = data;
+   E_Thumb_Cache_Oldest *old = fdata;
+
+   /* directories being looked at are never evicted */
+   if (eina_hash_find(_cache_dirs, key)) return EINA_TRUE;
+   if ((!old->id) || (ld->used < old->used))
+     {
+        old->id = key;
+        old->used = ld->used;
+     }
+   return EINA_TRUE;
+}
+
+static void
+_e_thumb_cache_trim(E_Thumb_Cache_Lru *lru)
+{
+   E_Thumb_Cache_Lru_Dir *ld;
+   Eina_Iterator *it;
+   Eina_List *files = NULL;
+   long long total = 0;
+   char buf[PATH_MAX];
+
+   it = eina_hash_iterator_data_new(lru->dirs);
+   EINA_ITERATOR_FOREACH(it, ld) total += ld->bytes;
+   eina_iterator_free(it);
+
+   /* least recently used directories go first, as a whole, so no index */
+   /* is ever left pointing at a thumb that is gone */
+   while (total > E_THUMB_CACHE_MAX)
+     {
+        E_Thumb_Cache_Oldest old = { NULL, 0.0 };
+        E_Thumb_Cache_Dir *cd;
+        char id[41];
+
+        eina_hash_foreach(lru->dirs, _e_thumb_cache_oldest_cb, &old);
+        if (!old.id) break;
+        eina_strlcpy(id, old.id, sizeof(id));
+        ld = eina_hash_find(lru->dirs, id);
+        total -= ld->bytes;
+        eina_hash_del_by_key(lru->dirs, id);
+        free(ld);
+        cd = _e_thumb_cache_dir_load(id);
+        if (cd)
+          {
+             eina_hash_foreach(cd->entries, _e_thumb_cache_unlink_list_cb, &files);
+             _e_thumb_cache_dir_free(cd);
+          }
+        unlink(_e_thumb_cache_file_get(id, buf, sizeof(buf)));
+     }
+   if (files)
+     ecore_thread_run(_e_thumb_cache_unlink, _e_thumb_cache_unlink_end,
+                      _e_thumb_cache_unlink_end, files);
+}
+
+static void
+_e_thumb_cache_flush(Eina_Bool all)
+{
+   E_Thumb_Cache_Lru *lru = NULL;
+   E_Thumb_Cache_Dir *cd;
+   Eina_Iterator *it;
+   Eina_List *idle = NULL;
+   Eet_File *ef;
+   char buf[PATH_MAX];
+   double now = ecore_time_unix_get();
+
+   if ((!_cache_dirs) || (!_cache_lru_edd)) return;
+   /* the lru only changes when a directory was used or its thumbs changed */
+   if (_cache_lru_dirty)
+     {
+        ef = eet_open(_e_thumb_cache_file_get("lru", buf, sizeof(buf)), EET_FILE_MODE_READ);
+        if (ef)
+          {
+             lru = eet_data_read(ef, _cache_lru_edd, "lru");
+             eet_close(ef);
+          }
+        if (!lru) lru = E_NEW(E_Thumb_Cache_Lru, 1);
+        if ((lru) && (!lru->dirs)) lru->dirs = eina_hash_string_superfast_new(NULL);
+     }
+
+   it = eina_hash_iterator_data_new(_cache_dirs);
+   EINA_ITERATOR_FOREACH(it, cd)
+     {
+        E_Thumb_Cache_Lru_Dir *ld = NULL;
+
+        if (lru)
+          {
+             ld = eina_hash_find(lru->dirs, cd->id);
+             if (!ld)
+               {
+                  ld = E_NEW(E_Thumb_Cache_Lru_Dir, 1);
+                  eina_hash_add(lru->dirs, cd->id, ld);
+               }
+             if (cd->used > ld->used) ld->used = cd->used;
+          }
+        if (cd->dirty)
+          {
+             if (ld)
+               {
+                  ld->bytes = 0;
+                  eina_hash_foreach(cd->entries, _e_thumb_cache_bytes_cb, &ld->bytes);
+               }
+             ef = eet_open(_e_thumb_cache_file_get(cd->id, buf, sizeof(buf)),
+                           EET_FILE_MODE_WRITE);
+             if (ef)
+               {
+                  eet_data_write(ef, _cache_dir_edd, "index", cd, 1);
+                  eet_close(ef);
+               }
+             cd->dirty = 0;
+          }
+        if ((all) || ((now - cd->used) > E_THUMB_CACHE_IDLE))
+          idle = eina_list_append(idle, cd);
+     }
+   eina_iterator_free(it);
+   EINA_LIST_FREE(idle, cd)
+     {
+        eina_hash_del_by_key(_cache_dirs, cd->id);
+        _e_thumb_cache_dir_free(cd);
+     }
+
+   if (!lru) return;
+   _e_thumb_cache_trim(lru);
+   ef = eet_open(_e_thumb_cache_file_get("lru", buf, sizeof(buf)), EET_FILE_MODE_WRITE);
+   if (ef)
+     {
+        eet_data_write(ef, _cache_lru_edd, "lru", lru, 1);
+        eet_close(ef);
+     }
+   _e_thumb_cache_lru_free(lru);
+   _cache_lru_dirty = EINA_FALSE;
+}
+
+static Eina_Bool
+_e_thumb_cache_cb_flush(void *data EINA_UNUSED)
+{
+   _e_thumb_cache_flush(EINA_FALSE);
+   if (eina_hash_population(_cache_dirs) > 0)
+     return ECORE_CALLBACK_RENEW;
+   _cache_flush_timer = NULL;
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_e_thumb_cache_flush_queue(void)
+{
+   if (_cache_flush_timer) return;
+   _cache_flush_timer = ecore_timer_loop_add(E_THUMB_CACHE_FLUSH,
+                                             _e_thumb_cache_cb_flush, NULL);
+}
+
+static void
+_e_thumb_cache_add(E_Thumb *eth, const char *icon)
+{
+   E_Thumb_Cache_Dir *cd;
+   E_Thumb_Cache_Entry *ce;
+   struct stat st, st2;
+   char key[PATH_MAX + 256];
+
+   if (stat(eth->file, &st)) return;
+   if (stat(icon, &st2)) return;
+   cd = _e_thumb_cache_dir_get(eth->file, EINA_TRUE);
+   if (!cd) return;
+   _e_thumb_cache_key(eth, key, sizeof(key));
+   ce = eina_hash_find(cd->entries, key);
+   if (!ce)
+     {
+        ce = E_NEW(E_Thumb_Cache_Entry, 1);
+        if (!ce) return;
+        eina_hash_add(cd->entries, key, ce);
+     }
+   eina_stringshare_replace(&ce->thumb, icon);
+   eina_stringshare_replace(&ce->sort_id, eth->sort_id);
+   ce->mtime = st.st_mtime;
+   ce->size = st.st_size;
+   ce->bytes = st2.st_size;
+   cd->dirty = 1;
+   _e_thumb_cache_flush_queue();
+}
+
+static void
+_e_thumb_cache_del(E_Thumb *eth)
+{
+   E_Thumb_Cache_Dir *cd;
+   E_Thumb_Cache_Entry *ce;
+   char key[PATH_MAX + 256];
+
+   if (!eth->file) return;
+   cd = _e_thumb_cache_dir_get(eth->file, EINA_FALSE);
+   if (!cd) return;
+   _e_thumb_cache_key(eth, key, sizeof(key));
+   ce = eina_hash_find(cd->entries, key);
+   if (!ce) return;
+   eina_hash_del_by_key(cd->entries, key);
+   _e_thumb_cache_entry_free_cb(NULL, NULL, ce, NULL);
+   cd->dirty = 1;
+   _e_thumb_cache_flush_queue();
+}
+
+static void
+_e_thumb_cache_shutdown(void)
+{
+   if (_cache_flush_timer) ecore_timer_del(_cache_flush_timer);
+   _cache_flush_timer = NULL;
+   _e_thumb_cache_flush(EINA_TRUE);
+   E_FREE_FUNC(_cache_dirs, eina_hash_free);
+   E_FREE_FUNC(_cache_dirs_missing, eina_hash_free);
+   E_FREE_FUNC(_cache_entry_edd, eet_data_descriptor_free);
+   E_FREE_FUNC(_cache_dir_edd, eet_data_descriptor_free);
+   E_FREE_FUNC(_cache_lru_dir_edd, eet_data_descriptor_free);
+   E_FREE_FUNC(_cache_lru_edd, eet_data_descriptor_free);
+}
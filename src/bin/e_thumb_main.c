@@ -44,6 +44,25 @@ struct _E_Thumb
    char      *key;
 };
 
+typedef struct _E_Thumb_Job E_Thumb_Job;
+
+struct _E_Thumb_Job
+{
+   E_Thumb       *eth;
+   Ecore_Evas    *ee, *ee_im;
+   Evas_Object   *im, *im2, *bg, *edje;
+   Ecore_Thread  *thread;
+   unsigned int  *data;
+   int            w, h, alpha;
+   int            sort_id_len;
+   unsigned char  sort_id[(21 * 4) + 1];
+   char           path[PATH_MAX + 200];
+   Eina_Bool      sortkey : 1;
+   Eina_Bool      preload : 1;
+   Eina_Bool      ready : 1;
+   Eina_Bool      cancel : 1;
+};
+
 /* local subsystem functions */
 static int       _e_ipc_init(void);
 static Eina_Bool _e_ipc_cb_server_add(void *data,
@@ -56,7 +75,13 @@ static Eina_Bool _e_ipc_cb_server_data(void *data,
                                        int type,
                                        void *event);
 static Eina_Bool _e_cb_idle_enterer(void *data);
+static void      _e_thumb_free(E_Thumb *eth);
+static void      _e_thumb_reply(int objid, const char *path);
 static void      _e_thumb_generate(E_Thumb *eth);
+static void      _e_thumb_job_process(E_Thumb_Job *job);
+static void      _e_thumb_job_canvas_free(E_Thumb_Job *job);
+static void      _e_thumb_job_free(E_Thumb_Job *job);
+static void      _e_thumb_job_cancel(int objid);
 static char     *_e_thumb_file_id(char *file,
                                   char *key,
                                   int desk_x,
@@ -69,13 +94,24 @@ static char     *_e_thumb_file_id(char *file,
 static Ecore_Idle_Enterer *_idle_enterer = NULL;
 static Ecore_Ipc_Server *_e_ipc_server = NULL;
 static Eina_List *_thumblist = NULL;
+static Eina_List *_thumbjobs = NULL;
+static int _thumbjobs_max = 1;
 static char _thumbdir[4096] = "";
 
+static struct
+{
+   Eina_Bool    report;
+   unsigned int done;
+   double       start;
+} _thumbstats = { EINA_FALSE, 0, 0.0 };
+
 /* externally accessible functions */
 int
 main(int argc,
      char **argv)
 {
+   Eina_List *l, *ll;
+   E_Thumb_Job *job;
    int i;
 
    for (i = 1; i < argc; i++)
@@ -116,6 +152,12 @@ main(int argc,
    e_user_dir_concat_static(_thumbdir, "fileman/thumbnails");
    ecore_file_mkpath(_thumbdir);
 
+   /* images decode in evas' preload threads and thumbs are encoded in */
+   /* ecore threads, so keep about one job in flight per core */
+   _thumbjobs_max = eina_cpu_count();
+   if (_thumbjobs_max < 1) _thumbjobs_max = 1;
+   if (getenv("E_THUMB_STATS")) _thumbstats.report = EINA_TRUE;
+
    _idle_enterer = ecore_idle_enterer_add(_e_cb_idle_enterer, NULL);
    if (_idle_enterer)
      {
@@ -124,6 +166,17 @@ main(int argc,
         _idle_enterer = NULL;
      }
 
+   /* jobs still encoding are owned by their thread until ecore joins it */
+   EINA_LIST_FOREACH_SAFE(_thumbjobs, l, ll, job)
+     {
+        if (!job->thread) _e_thumb_job_free(job);
+     }
+   while (_thumblist)
+     {
+        _e_thumb_free(eina_list_data_get(_thumblist));
+        _thumblist = eina_list_remove_list(_thumblist, _thumblist);
+     }
+
    if (_e_ipc_server)
      {
         ecore_ipc_server_del(_e_ipc_server);
@@ -245,7 +298,9 @@ _e_ipc_cb_server_data(void *data EINA_UNUSED,
                   eth->desk_y_count = desk[3];
                   eth->sigsrc = sigsrc;
                   if (key) eth->key = strdup(key);
-                  _thumblist = eina_list_append(_thumblist, eth);
+                  /* most recent requests are the icons the user is looking */
+                  /* at right now, so serve the queue newest first */
+                  _thumblist = eina_list_prepend(_thumblist, eth);
                }
           }
         break;
@@ -257,12 +312,11 @@ _e_ipc_cb_server_data(void *data EINA_UNUSED,
              if (eth->objid == e->ref)
                {
                   _thumblist = eina_list_remove_list(_thumblist, l);
-                  free(eth->file);
-                  free(eth->key);
-                  free(eth);
+                  _e_thumb_free(eth);
                   break;
                }
           }
+        _e_thumb_job_cancel(e->ref);
         break;
 
       case 3:
@@ -284,25 +338,177 @@ _cb_wakeup(void *data EINA_UNUSED)
 static Eina_Bool
 _e_cb_idle_enterer(void *data EINA_UNUSED)
 {
+   E_Thumb_Job *job;
    E_Thumb *eth;
+   Eina_List *l, *ll;
 
-   /* take thumb at head of list */
-   if (_thumblist)
+   /* finish decoded images first - they only need scaling and handing */
+   /* over to an encoder thread */
+   EINA_LIST_FOREACH_SAFE(_thumbjobs, l, ll, job)
+     {
+        if (job->ready)
+          {
+             job->ready = 0;
+             _e_thumb_job_process(job);
+          }
+     }
+   /* then take thumbs from the head of list while there is a free worker */
+   while ((_thumblist) && ((int)eina_list_count(_thumbjobs) < _thumbjobs_max))
      {
-        const char *s;
-
         eth = eina_list_data_get(_thumblist);
         _thumblist = eina_list_remove_list(_thumblist, _thumblist);
         _e_thumb_generate(eth);
-        EINA_LIST_FREE(eth->sigsrc, s) eina_stringshare_del(s);
-        free(eth->file);
-        free(eth->key);
-        free(eth);
-        if (_thumblist) ecore_job_add(_cb_wakeup, NULL);
+     }
+   if ((_thumbstats.report) && (_thumbstats.done > 0) &&
+       (!_thumblist) && (!_thumbjobs))
+     {
+        double t = ecore_time_get() - _thumbstats.start;
+
+        if (t <= 0.0) t = 0.001;
+        printf("THUMB: %u thumbs in %1.3fs (%1.1f/s, %i workers)\n",
+               _thumbstats.done, t, (double)_thumbstats.done / t,
+               _thumbjobs_max);
+        _thumbstats.done = 0;
+        _thumbstats.start = 0.0;
      }
    return ECORE_CALLBACK_RENEW;
 }
 
+static void
+_e_thumb_free(E_Thumb *eth)
+{
+   const char *s;
+
+   EINA_LIST_FREE(eth->sigsrc, s) eina_stringshare_del(s);
+   free(eth->file);
+   free(eth->key);
+   free(eth);
+}
+
+static void
+_e_thumb_reply(int objid, const char *path)
+{
+   /* send back path to thumb */
+   if (!_e_ipc_server) return;
+   ecore_ipc_server_send(_e_ipc_server, 5, 2, objid, 0, 0, path, strlen(path) + 1);
+}
+
+static void
+_e_thumb_job_canvas_free(E_Thumb_Job *job)
+{
+   /* will free all */
+   if (job->edje) evas_object_del(job->edje);
+   if (job->ee_im) ecore_evas_free(job->ee_im);
+   else if (job->im) evas_object_del(job->im);
+   if (job->im2) evas_object_del(job->im2);
+   if (job->bg) evas_object_del(job->bg);
+   if (job->ee) ecore_evas_free(job->ee);
+   job->edje = NULL;
+   job->ee_im = NULL;
+   job->im = NULL;
+   job->im2 = NULL;
+   job->bg = NULL;
+   job->ee = NULL;
+}
+
+static void
+_e_thumb_job_free(E_Thumb_Job *job)
+{
+   _thumbjobs = eina_list_remove(_thumbjobs, job);
+   if ((job->preload) && (job->im))
+     evas_object_image_preload(job->im, EINA_TRUE);
+   _e_thumb_job_canvas_free(job);
+   free(job->data);
+   if (job->eth) _e_thumb_free(job->eth);
+   free(job);
+   if (_thumblist) ecore_job_add(_cb_wakeup, NULL);
+}
+
+static void
+_e_thumb_job_done(E_Thumb_Job *job)
+{
+   if (!job->cancel)
+     {
+        _e_thumb_reply(job->eth->objid, job->path);
+        _thumbstats.done++;
+     }
+   _e_thumb_job_free(job);
+}
+
+static void
+_e_thumb_job_cancel(int objid)
+{
+   Eina_List *l;
+   E_Thumb_Job *job;
+
+   EINA_LIST_FOREACH(_thumbjobs, l, job)
+     {
+        if (job->eth->objid != objid) continue;
+        job->cancel = 1;
+        /* an encoder that has not started yet can just be dropped - a */
+        /* running one finishes its file and then skips the reply */
+        if (job->thread) ecore_thread_cancel(job->thread);
+        else _e_thumb_job_free(job);
+        break;
+     }
+}
+
+static void
+_e_thumb_job_write(void *data, Ecore_Thread *th EINA_UNUSED)
+{
+   E_Thumb_Job *job = data;
+   E_Thumb *eth = job->eth;
+   Eet_File *ef;
+
+   ef = eet_open(job->path, EET_FILE_MODE_WRITE);
+   if (!ef) return;
+   eet_write(ef, "/thumbnail/orig_file",
+             eth->file, strlen(eth->file), 1);
+   if (eth->key)
+     eet_write(ef, "/thumbnail/orig_key",
+               eth->key, strlen(eth->key), 1);
+   eet_data_image_write(ef, "/thumbnail/data",
+                        (void *)job->data, job->w, job->h, job->alpha,
+                        0, 91, 1);
+   if (job->sort_id_len > 0)
+     eet_write(ef, "/thumbnail/sort_id", job->sort_id, job->sort_id_len, 1);
+   eet_close(ef);
+}
+
+static void
+_e_thumb_job_write_end(void *data, Ecore_Thread *th EINA_UNUSED)
+{
+   E_Thumb_Job *job = data;
+
+   job->thread = NULL;
+   eet_clearcache();
+   _e_thumb_job_done(job);
+}
+
+static void
+_e_thumb_job_write_cancel(void *data, Ecore_Thread *th EINA_UNUSED)
+{
+   E_Thumb_Job *job = data;
+
+   /* either cancelled by e or the thread never ran - reply anyway */
+   /* unless e asked us to stop, it will see the thumb is missing */
+   job->thread = NULL;
+   _e_thumb_job_done(job);
+}
+
+static void
+_e_thumb_cb_preloaded(void *data, Evas *e EINA_UNUSED,
+                      Evas_Object *obj EINA_UNUSED, void *event EINA_UNUSED)
+{
+   E_Thumb_Job *job = data;
+
+   /* don't render from inside the canvas callback - let the idle */
+   /* enterer pick it up */
+   job->preload = 0;
+   job->ready = 1;
+   ecore_job_add(_cb_wakeup, NULL);
+}
+
 typedef struct _Color Color;
 
 struct _Color
@@ -316,13 +522,10 @@ struct _Color
 static void
 _e_thumb_generate(E_Thumb *eth)
 {
-   char buf[PATH_MAX + 200], dbuf[PATH_MAX + 2], *id, *td, *ext = NULL;
+   char dbuf[PATH_MAX + 2], *id, *td, *ext = NULL;
    Evas *evas = NULL, *evas_im = NULL;
-   Ecore_Evas *ee = NULL, *ee_im = NULL;
-   Evas_Object *im = NULL, *edje = NULL;
-   Eet_File *ef = NULL;
-   int iw, ih, alpha, ww, hh;
-   const unsigned int *data = NULL;
+   E_Thumb_Job *job;
+   int iw, ih;
    time_t mtime_orig, mtime_thumb;
 
    id = _e_thumb_file_id(eth->file, eth->key,
@@ -330,281 +533,303 @@ _e_thumb_generate(E_Thumb *eth)
 //                         eth->desk_x, eth->desk_y,
 //                         eth->desk_x_count, eth->desk_y_count,
                          eth->sigsrc);
-   if (!id) return;
+   if (!id)
+     {
+        _e_thumb_free(eth);
+        return;
+     }
 
    td = strdup(id);
    if (!td)
      {
         free(id);
+        _e_thumb_free(eth);
         return;
      }
    td[2] = 0;
 
+   job = calloc(1, sizeof(E_Thumb_Job));
+   if (!job)
+     {
+        free(id);
+        free(td);
+        _e_thumb_free(eth);
+        return;
+     }
+   job->eth = eth;
+   if (!_thumbstats.start) _thumbstats.start = ecore_time_get();
+   _thumbjobs = eina_list_append(_thumbjobs, job);
+
    snprintf(dbuf, sizeof(dbuf), "%s/%s", _thumbdir, td);
-   snprintf(buf, sizeof(buf), "%s/%s/%s-%ix%i.thm",
+   snprintf(job->path, sizeof(job->path), "%s/%s/%s-%ix%i.thm",
             _thumbdir, td, id + 2, eth->w, eth->h);
    free(id);
    free(td);
 
    mtime_orig = ecore_file_mod_time(eth->file);
-   mtime_thumb = ecore_file_mod_time(buf);
-   while (mtime_thumb <= mtime_orig)
+   mtime_thumb = ecore_file_mod_time(job->path);
+   if (mtime_thumb > mtime_orig)
      {
-        unsigned int *data1;
-        Eina_Bool sortkey;
-        Evas_Object *im2, *bg;
-
-        im = NULL;
-        im2 = NULL;
-        bg = NULL;
-
-        ecore_file_mkdir(dbuf);
-
-        edje_file_cache_set(0);
-        edje_collection_cache_set(0);
-        ee = ecore_evas_buffer_new(1, 1);
-        evas = ecore_evas_get(ee);
-        evas_image_cache_set(evas, 0);
-        evas_font_cache_set(evas, 0);
-        ww = 0;
-        hh = 0;
-        alpha = 1;
-        ext = strrchr(eth->file, '.');
-
-        sortkey = EINA_FALSE;
-
-        if (emotion_object_extension_may_play_get(eth->file))
-          {
-             Evas_Object *em;
+        _e_thumb_job_done(job);
+        return;
+     }
 
-             em = emotion_object_add(evas);
-             emotion_object_init(em, NULL);
-             emotion_object_file_set(em, eth->file);
+   ecore_file_mkdir(dbuf);
 
-             im = emotion_file_meta_artwork_get(em, eth->file, EMOTION_ARTWORK_PREVIEW_IMAGE);
-             if (!im) im = emotion_file_meta_artwork_get(em, eth->file, EMOTION_ARTWORK_IMAGE);
-             if (im)
-               {
-                  evas_object_image_size_get(im, &ww, &hh);
-                  evas_object_image_fill_set(im, 0, 0, ww, hh);
-                  evas_object_move(im, 0, 0);
-                  evas_object_resize(im, ww, hh);
-               }
-             evas_object_del(em);
-             if (im) goto process;
+   edje_file_cache_set(0);
+   edje_collection_cache_set(0);
+   job->ee = ecore_evas_buffer_new(1, 1);
+   evas = ecore_evas_get(job->ee);
+   evas_image_cache_set(evas, 0);
+   evas_font_cache_set(evas, 0);
+   job->w = 0;
+   job->h = 0;
+   job->alpha = 1;
+   ext = strrchr(eth->file, '.');
+
+   if (emotion_object_extension_may_play_get(eth->file))
+     {
+        Evas_Object *em;
+
+        em = emotion_object_add(evas);
+        emotion_object_init(em, NULL);
+        emotion_object_file_set(em, eth->file);
+
+        job->im = emotion_file_meta_artwork_get(em, eth->file, EMOTION_ARTWORK_PREVIEW_IMAGE);
+        if (!job->im) job->im = emotion_file_meta_artwork_get(em, eth->file, EMOTION_ARTWORK_IMAGE);
+        if (job->im)
+          {
+             evas_object_image_size_get(job->im, &job->w, &job->h);
+             evas_object_image_fill_set(job->im, 0, 0, job->w, job->h);
+             evas_object_move(job->im, 0, 0);
+             evas_object_resize(job->im, job->w, job->h);
+          }
+        evas_object_del(em);
+        if (job->im)
+          {
+             _e_thumb_job_process(job);
+             return;
           }
+     }
 
-        if ((ext) && (eth->key) &&
-            ((!strcasecmp(ext, ".edj")) ||
-             (!strcasecmp(ext, ".eap"))))
+   if ((ext) && (eth->key) &&
+       ((!strcasecmp(ext, ".edj")) ||
+        (!strcasecmp(ext, ".eap"))))
+     {
+        Eina_List *l;
+
+        job->w = eth->w;
+        job->h = eth->h;
+        job->im = ecore_evas_object_image_new(job->ee);
+        job->ee_im = evas_object_data_get(job->im, "Ecore_Evas");
+        evas_im = ecore_evas_get(job->ee_im);
+        evas_image_cache_set(evas_im, 0);
+        evas_font_cache_set(evas_im, 0);
+        evas_object_image_size_set(job->im, job->w * 4, job->h * 4);
+        evas_object_image_fill_set(job->im, 0, 0, job->w, job->h);
+        job->edje = edje_object_add(evas_im);
+        if ((eth->key) &&
+            ((!strcmp(eth->key, "e/desktop/background")) ||
+             (!strcmp(eth->key, "e/init/splash"))))
+          job->alpha = 0;
+        if (edje_object_file_set(job->edje, eth->file, eth->key))
           {
-             Eina_List *l;
-
-             ww = eth->w;
-             hh = eth->h;
-             im = ecore_evas_object_image_new(ee);
-             ee_im = evas_object_data_get(im, "Ecore_Evas");
-             evas_im = ecore_evas_get(ee_im);
-             evas_image_cache_set(evas_im, 0);
-             evas_font_cache_set(evas_im, 0);
-             evas_object_image_size_set(im, ww * 4, hh * 4);
-             evas_object_image_fill_set(im, 0, 0, ww, hh);
-             edje = edje_object_add(evas_im);
-             if ((eth->key) &&
-                 ((!strcmp(eth->key, "e/desktop/background")) ||
-                  (!strcmp(eth->key, "e/init/splash"))))
-               alpha = 0;
-             if (edje_object_file_set(edje, eth->file, eth->key))
-               {
-                  evas_object_move(edje, 0, 0);
-                  evas_object_resize(edje, ww * 4, hh * 4);
-                  evas_object_show(edje);
-               }
-             if ((eth->desk_x_count > 0) &&
-                 (eth->desk_y_count > 0))
-               {
-                  Edje_Message_Float_Set *msg;
-
-                  msg = alloca(sizeof(Edje_Message_Float_Set) +
-                               (4 * sizeof(double)));
-                  msg->count = 5;
-                  msg->val[0] = 0.0;
-                  msg->val[1] = eth->desk_x;
-                  msg->val[2] = eth->desk_x_count;
-                  msg->val[3] = eth->desk_y;
-                  msg->val[4] = eth->desk_y_count;
-                  edje_object_message_send(edje, EDJE_MESSAGE_FLOAT_SET,
-                                           0, msg);
-               }
-             l = eth->sigsrc;
-             while (l)
-               {
-                  const char *sig, *src;
+             evas_object_move(job->edje, 0, 0);
+             evas_object_resize(job->edje, job->w * 4, job->h * 4);
+             evas_object_show(job->edje);
+          }
+        if ((eth->desk_x_count > 0) &&
+            (eth->desk_y_count > 0))
+          {
+             Edje_Message_Float_Set *msg;
+
+             msg = alloca(sizeof(Edje_Message_Float_Set) +
+                          (4 * sizeof(double)));
+             msg->count = 5;
+             msg->val[0] = 0.0;
+             msg->val[1] = eth->desk_x;
+             msg->val[2] = eth->desk_x_count;
+             msg->val[3] = eth->desk_y;
+             msg->val[4] = eth->desk_y_count;
+             edje_object_message_send(job->edje, EDJE_MESSAGE_FLOAT_SET,
+                                      0, msg);
+          }
+        l = eth->sigsrc;
+        while (l)
+          {
+             const char *sig, *src;
 
-                  sig = l->data;
+             sig = l->data;
+             l = l->next;
+             if (l)
+               {
+                  src = l->data;
                   l = l->next;
-                  if (l)
-                    {
-                       src = l->data;
-                       l = l->next;
-                       edje_object_signal_emit(edje, sig, src);
-                    }
+                  edje_object_signal_emit(job->edje, sig, src);
                }
-             edje_object_message_signal_process(edje);
-             evas_object_move(im, 0, 0);
-             evas_object_resize(im, ww, hh);
-             sortkey = EINA_TRUE;
           }
-        else if ((ext) &&
-                 ((!strcasecmp(ext, ".ttf")) ||
-                  (!strcasecmp(ext, ".pcf")) ||
-                  (!strcasecmp(ext, ".bdf")) ||
-                  (!strcasecmp(ext, ".ttx")) ||
-                  (!strcasecmp(ext, ".pfa")) ||
-                  (!strcasecmp(ext, ".pfb")) ||
-                  (!strcasecmp(ext, ".afm")) ||
-                  (!strcasecmp(ext, ".sfd")) ||
-                  (!strcasecmp(ext, ".snf")) ||
-                  (!strcasecmp(ext, ".otf")) ||
-                  (!strcasecmp(ext, ".psf")) ||
-                  (!strcasecmp(ext, ".ttc")) ||
-                  (!strcasecmp(ext, ".ttx")) ||
-                  (!strcasecmp(ext, ".gsf")) ||
-                  (!strcasecmp(ext, ".spd"))
-                 ))
-          {
-             Evas_Coord tx = 0, ty = 0, tw = 0, th = 0;
-             ww = eth->w;
-             hh = eth->h;
-             alpha = 0;
-
-             bg = evas_object_rectangle_add(evas);
-             evas_object_color_set(bg, 96, 96, 96, 255);
-             evas_object_move(bg, 0, 0);
-             evas_object_resize(bg, ww, hh);
-             evas_object_show(bg);
-
-             im = evas_object_text_add(evas);
-             evas_object_text_font_set(im, eth->file, hh / 4);
-             evas_object_color_set(im, 192, 192, 192, 255);
-             evas_object_text_ellipsis_set(im, 0.0);
-             evas_object_text_text_set(im, "ABCabc");
-             evas_object_geometry_get(im, NULL, NULL, &tw, &th);
-             if (tw > ww) tw = ww;
-             tx = 0 + ((ww - tw) / 2);
-             ty = 0 + (((hh / 2) - th) / 2);
-             evas_object_move(im, tx, ty);
-             evas_object_resize(im, tw, th);
-             evas_object_show(im);
-
-             im2 = evas_object_text_add(evas);
-             evas_object_text_font_set(im2, eth->file, hh / 4);
-             evas_object_color_set(im2, 255, 255, 255, 255);
-             evas_object_text_ellipsis_set(im2, 0.0);
-             evas_object_text_text_set(im2, "123!@?");
-             evas_object_geometry_get(im2, NULL, NULL, &tw, &th);
-             if (tw > ww) tw = ww;
-             tx = 0 + ((ww - tw) / 2);
-             ty = (hh / 2) + (((hh / 2) - th) / 2);
-             evas_object_move(im2, tx, ty);
-             evas_object_resize(im2, tw, th);
-             evas_object_show(im2);
-          }
-        else if (evas_object_image_extension_can_load_get(ext))
+        edje_object_message_signal_process(job->edje);
+        evas_object_move(job->im, 0, 0);
+        evas_object_resize(job->im, job->w, job->h);
+        job->sortkey = EINA_TRUE;
+     }
+   else if ((ext) &&
+            ((!strcasecmp(ext, ".ttf")) ||
+             (!strcasecmp(ext, ".pcf")) ||
+             (!strcasecmp(ext, ".bdf")) ||
+             (!strcasecmp(ext, ".ttx")) ||
+             (!strcasecmp(ext, ".pfa")) ||
+             (!strcasecmp(ext, ".pfb")) ||
+             (!strcasecmp(ext, ".afm")) ||
+             (!strcasecmp(ext, ".sfd")) ||
+             (!strcasecmp(ext, ".snf")) ||
+             (!strcasecmp(ext, ".otf")) ||
+             (!strcasecmp(ext, ".psf")) ||
+             (!strcasecmp(ext, ".ttc")) ||
+             (!strcasecmp(ext, ".ttx")) ||
+             (!strcasecmp(ext, ".gsf")) ||
+             (!strcasecmp(ext, ".spd"))
+            ))
+     {
+        Evas_Coord tx = 0, ty = 0, tw = 0, th = 0;
+        int ww = eth->w, hh = eth->h;
+
+        job->w = ww;
+        job->h = hh;
+        job->alpha = 0;
+
+        job->bg = evas_object_rectangle_add(evas);
+        evas_object_color_set(job->bg, 96, 96, 96, 255);
+        evas_object_move(job->bg, 0, 0);
+        evas_object_resize(job->bg, ww, hh);
+        evas_object_show(job->bg);
+
+        job->im = evas_object_text_add(evas);
+        evas_object_text_font_set(job->im, eth->file, hh / 4);
+        evas_object_color_set(job->im, 192, 192, 192, 255);
+        evas_object_text_ellipsis_set(job->im, 0.0);
+        evas_object_text_text_set(job->im, "ABCabc");
+        evas_object_geometry_get(job->im, NULL, NULL, &tw, &th);
+        if (tw > ww) tw = ww;
+        tx = 0 + ((ww - tw) / 2);
+        ty = 0 + (((hh / 2) - th) / 2);
+        evas_object_move(job->im, tx, ty);
+        evas_object_resize(job->im, tw, th);
+        evas_object_show(job->im);
+
+        job->im2 = evas_object_text_add(evas);
+        evas_object_text_font_set(job->im2, eth->file, hh / 4);
+        evas_object_color_set(job->im2, 255, 255, 255, 255);
+        evas_object_text_ellipsis_set(job->im2, 0.0);
+        evas_object_text_text_set(job->im2, "123!@?");
+        evas_object_geometry_get(job->im2, NULL, NULL, &tw, &th);
+        if (tw > ww) tw = ww;
+        tx = 0 + ((ww - tw) / 2);
+        ty = (hh / 2) + (((hh / 2) - th) / 2);
+        evas_object_move(job->im2, tx, ty);
+        evas_object_resize(job->im2, tw, th);
+        evas_object_show(job->im2);
+     }
+   else if (evas_object_image_extension_can_load_get(ext))
+     {
+        job->im = evas_object_image_add(evas);
+        evas_object_image_load_orientation_set(job->im, EINA_TRUE);
+        evas_object_image_load_size_set(job->im, eth->w, eth->h);
+        evas_object_image_file_set(job->im, eth->file, NULL);
+        iw = 0; ih = 0;
+        evas_object_image_size_get(job->im, &iw, &ih);
+        job->alpha = evas_object_image_alpha_get(job->im);
+        if ((iw > 0) && (ih > 0))
           {
-             im = evas_object_image_add(evas);
-             evas_object_image_load_orientation_set(im, EINA_TRUE);
-             evas_object_image_load_size_set(im, eth->w, eth->h);
-             evas_object_image_file_set(im, eth->file, NULL);
-             iw = 0; ih = 0;
-             evas_object_image_size_get(im, &iw, &ih);
-             alpha = evas_object_image_alpha_get(im);
-             if ((iw > 0) && (ih > 0))
+             job->w = eth->w;
+             job->h = (eth->w * ih) / iw;
+             if (job->h > eth->h)
                {
-                  ww = eth->w;
-                  hh = (eth->w * ih) / iw;
-                  if (hh > eth->h)
-                    {
-                       hh = eth->h;
-                       ww = (eth->h * iw) / ih;
-                    }
-                  evas_object_image_fill_set(im, 0, 0, ww, hh);
+                  job->h = eth->h;
+                  job->w = (eth->h * iw) / ih;
                }
-             evas_object_move(im, 0, 0);
-             evas_object_resize(im, ww, hh);
-             sortkey = EINA_TRUE;
+             evas_object_image_fill_set(job->im, 0, 0, job->w, job->h);
+          }
+        evas_object_move(job->im, 0, 0);
+        evas_object_resize(job->im, job->w, job->h);
+        job->sortkey = EINA_TRUE;
+        if (evas_object_image_load_error_get(job->im) == EVAS_LOAD_ERROR_NONE)
+          {
+             /* only the header is loaded so far - decode the pixels in */
+             /* the evas preload threads and come back when done */
+             evas_object_event_callback_add(job->im,
+                                            EVAS_CALLBACK_IMAGE_PRELOADED,
+                                            _e_thumb_cb_preloaded, job);
+             job->preload = 1;
+             evas_object_image_preload(job->im, EINA_FALSE);
+             return;
           }
-        else
-          goto end;
-
-process:
-        ecore_evas_alpha_set(ee, alpha);
-        ecore_evas_resize(ee, ww, hh);
-        evas_object_show(im);
-        if (ww <= 0) goto end;
-        data = ecore_evas_buffer_pixels_get(ee);
-        if (!data) goto end;
-        ef = eet_open(buf, EET_FILE_MODE_WRITE);
-        if (!ef) goto end;
-        eet_write(ef, "/thumbnail/orig_file",
-                  eth->file, strlen(eth->file), 1);
-        if (eth->key)
-          eet_write(ef, "/thumbnail/orig_key",
-                    eth->key, strlen(eth->key), 1);
-        eet_data_image_write(ef, "/thumbnail/data",
-                             (void *)data, ww, hh, alpha,
-                             0, 91, 1);
-        if (sortkey)
+     }
+   else
+     {
+        _e_thumb_job_canvas_free(job);
+        _e_thumb_job_done(job);
+        return;
+     }
+   _e_thumb_job_process(job);
+}
+
+static void
+_e_thumb_sort_id_calc(E_Thumb_Job *job)
+{
+   const unsigned int *data;
+   unsigned int *data1;
+   int ww, hh;
+
+   ww = 4; hh = 4;
+   evas_object_image_fill_set(job->im, 0, 0, ww, hh);
+   evas_object_resize(job->im, ww, hh);
+   ecore_evas_resize(job->ee, ww, hh);
+   data = ecore_evas_buffer_pixels_get(job->ee);
+   if (!data) return;
+
+   data1 = malloc(ww * hh * sizeof(unsigned int));
+   memcpy(data1, data, ww * hh * sizeof(unsigned int));
+   ww = 2; hh = 2;
+   evas_object_image_fill_set(job->im, 0, 0, ww, hh);
+   evas_object_resize(job->im, ww, hh);
+   ecore_evas_resize(job->ee, ww, hh);
+   data = ecore_evas_buffer_pixels_get(job->ee);
+   if (data)
+     {
+        unsigned int *data2;
+
+        data2 = malloc(ww * hh * sizeof(unsigned int));
+        memcpy(data2, data, ww * hh * sizeof(unsigned int));
+        ww = 1; hh = 1;
+        evas_object_image_fill_set(job->im, 0, 0, ww, hh);
+        evas_object_resize(job->im, ww, hh);
+        ecore_evas_resize(job->ee, ww, hh);
+        data = ecore_evas_buffer_pixels_get(job->ee);
+        if (data)
           {
-             ww = 4; hh = 4;
-             evas_object_image_fill_set(im, 0, 0, ww, hh);
-             evas_object_resize(im, ww, hh);
-             ecore_evas_resize(ee, ww, hh);
-             data = ecore_evas_buffer_pixels_get(ee);
-             if (!data) goto end;
-
-             data1 = malloc(ww * hh * sizeof(unsigned int));
-             memcpy(data1, data, ww * hh * sizeof(unsigned int));
-             ww = 2; hh = 2;
-             evas_object_image_fill_set(im, 0, 0, ww, hh);
-             evas_object_resize(im, ww, hh);
-             ecore_evas_resize(ee, ww, hh);
-             data = ecore_evas_buffer_pixels_get(ee);
-             if (data)
+             unsigned int *data3;
+             unsigned char *id2 = job->sort_id;
+             int n, i;
+             int hi, si, vi;
+             float h, s, v;
+             const int pat2[4] =
                {
-                  unsigned int *data2;
-
-                  data2 = malloc(ww * hh * sizeof(unsigned int));
-                  memcpy(data2, data, ww * hh * sizeof(unsigned int));
-                  ww = 1; hh = 1;
-                  evas_object_image_fill_set(im, 0, 0, ww, hh);
-                  evas_object_resize(im, ww, hh);
-                  ecore_evas_resize(ee, ww, hh);
-                  data = ecore_evas_buffer_pixels_get(ee);
-                  if (data)
-                    {
-                       unsigned int *data3;
-                       unsigned char id2[(21 * 4) + 1];
-                       int n, i;
-                       int hi, si, vi;
-                       float h, s, v;
-                       const int pat2[4] =
-                         {
-                            0, 3, 1, 2
-                         };
-                       const int pat1[16] =
-                         {
-                            5, 10, 6, 9,
-                            0, 15, 3, 12,
-                            1, 14, 7, 8,
-                            4, 11, 2, 13
-                         };
-
-                       /* ww = hh = 1 here */
-                       data3 = malloc(sizeof(unsigned int));
-                       memcpy(data3, data, sizeof(unsigned int));
-                       // sort_id
-                       n = 0;
+                  0, 3, 1, 2
+               };
+             const int pat1[16] =
+               {
+                  5, 10, 6, 9,
+                  0, 15, 3, 12,
+                  1, 14, 7, 8,
+                  4, 11, 2, 13
+               };
+
+             /* ww = hh = 1 here */
+             data3 = malloc(sizeof(unsigned int));
+             memcpy(data3, data, sizeof(unsigned int));
+             // sort_id
+             n = 0;
 #define A(v) (((v) >> 24) & 0xff)
 #define R(v) (((v) >> 16) & 0xff)
 #define G(v) (((v) >> 8) & 0xff)
@@ -622,79 +847,96 @@ process:
 #define SAVEX(x) \
   id2[n++] = 'a' + x;
 #if 0
-                       HSV(data3[0]);
-                       SAVEHSV(hi, si, vi);
-                       for (i = 0; i < 4; i++)
-                         {
-                            HSV(data2[pat2[i]]);
-                            SAVEHSV(hi, si, vi);
-                         }
-                       for (i = 0; i < 16; i++)
-                         {
-                            HSV(data1[pat1[i]]);
-                            SAVEHSV(hi, si, vi);
-                         }
+             HSV(data3[0]);
+             SAVEHSV(hi, si, vi);
+             for (i = 0; i < 4; i++)
+               {
+                  HSV(data2[pat2[i]]);
+                  SAVEHSV(hi, si, vi);
+               }
+             for (i = 0; i < 16; i++)
+               {
+                  HSV(data1[pat1[i]]);
+                  SAVEHSV(hi, si, vi);
+               }
 #else
-                       HSV(data3[0]);
-                       SAVEX(hi);
-                       for (i = 0; i < 4; i++)
-                         {
-                            HSV(data2[pat2[i]]);
-                            SAVEX(hi);
-                         }
-                       for (i = 0; i < 16; i++)
-                         {
-                            HSV(data1[pat1[i]]);
-                            SAVEX(hi);
-                         }
-                       HSV(data3[0]);
-                       SAVEX(vi);
-                       for (i = 0; i < 4; i++)
-                         {
-                            HSV(data2[pat2[i]]);
-                            SAVEX(vi);
-                         }
-                       for (i = 0; i < 16; i++)
-                         {
-                            HSV(data1[pat1[i]]);
-                            SAVEX(vi);
-                         }
-                       HSV(data3[0]);
-                       SAVEX(si);
-                       for (i = 0; i < 4; i++)
-                         {
-                            HSV(data2[pat2[i]]);
-                            SAVEX(si);
-                         }
-                       for (i = 0; i < 16; i++)
-                         {
-                            HSV(data1[pat1[i]]);
-                            SAVEX(si);
-                         }
-#endif
-                       id2[n++] = 0;
-                       eet_write(ef, "/thumbnail/sort_id", id2, n, 1);
-                       free(data3);
-                    }
-                  free(data2);
+             HSV(data3[0]);
+             SAVEX(hi);
+             for (i = 0; i < 4; i++)
+               {
+                  HSV(data2[pat2[i]]);
+                  SAVEX(hi);
+               }
+             for (i = 0; i < 16; i++)
+               {
+                  HSV(data1[pat1[i]]);
+                  SAVEX(hi);
                }
-             free(data1);
+             HSV(data3[0]);
+             SAVEX(vi);
+             for (i = 0; i < 4; i++)
+               {
+                  HSV(data2[pat2[i]]);
+                  SAVEX(vi);
+               }
+             for (i = 0; i < 16; i++)
+               {
+                  HSV(data1[pat1[i]]);
+                  SAVEX(vi);
+               }
+             HSV(data3[0]);
+             SAVEX(si);
+             for (i = 0; i < 4; i++)
+               {
+                  HSV(data2[pat2[i]]);
+                  SAVEX(si);
+               }
+             for (i = 0; i < 16; i++)
+               {
+                  HSV(data1[pat1[i]]);
+                  SAVEX(si);
+               }
+#endif
+             id2[n++] = 0;
+             job->sort_id_len = n;
+             free(data3);
           }
-end:
-        if (ef) eet_close(ef);
-
-        /* will free all */
-        if (edje) evas_object_del(edje);
-        if (ee_im) ecore_evas_free(ee_im);
-        else if (im) evas_object_del(im);
-        if (im2) evas_object_del(im2);
-        if (bg) evas_object_del(bg);
-        ecore_evas_free(ee);
-        eet_clearcache();
-        break;
+        free(data2);
      }
-   /* send back path to thumb */
-   ecore_ipc_server_send(_e_ipc_server, 5, 2, eth->objid, 0, 0, buf, strlen(buf) + 1);
+   free(data1);
+}
+
+static void
+_e_thumb_job_process(E_Thumb_Job *job)
+{
+   const unsigned int *data = NULL;
+   Ecore_Thread *th;
+
+   ecore_evas_alpha_set(job->ee, job->alpha);
+   ecore_evas_resize(job->ee, job->w, job->h);
+   evas_object_show(job->im);
+   if (job->w <= 0) goto end;
+   data = ecore_evas_buffer_pixels_get(job->ee);
+   if (!data) goto end;
+   job->data = malloc(job->w * job->h * sizeof(unsigned int));
+   if (!job->data) goto end;
+   memcpy(job->data, data, job->w * job->h * sizeof(unsigned int));
+   if (job->sortkey) _e_thumb_sort_id_calc(job);
+   _e_thumb_job_canvas_free(job);
+
+   /* the rendered pixels are ours now - compress and write them out */
+   /* on a worker while the canvas side moves on to the next thumb */
+   /* if no thread can be started ecore calls the cancel cb right away */
+   /* and that already replied and freed the job */
+   th = ecore_thread_run(_e_thumb_job_write,
+                         _e_thumb_job_write_end,
+                         _e_thumb_job_write_cancel,
+                         job);
+   if (th) job->thread = th;
+   return;
+end:
+   _e_thumb_job_canvas_free(job);
+   _e_thumb_job_done(job);
 }
 
 static char *
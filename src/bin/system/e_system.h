@@ -48,6 +48,7 @@ void *alloca (size_t);
 # include <sys/time.h>
 # include <sys/param.h>
 # include <sys/resource.h>
+# include <sys/uio.h>
 # include <utime.h>
 # include <dlfcn.h>
 # include <math.h>
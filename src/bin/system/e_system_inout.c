@@ -105,6 +105,14 @@ done:
    return EINA_TRUE;
 }
 
+static void
+_cb_ping(void *data EINA_UNUSED, const char *params)
+{
+   // echo straight back so e can measure the round trip
+   if (params) e_system_inout_command_send("pong", "%s", params);
+   else e_system_inout_command_send("pong", NULL);
+}
+
 void
 e_system_inout_init(void)
 {
@@ -113,6 +121,7 @@ e_system_inout_init(void)
    _fdh_in = ecore_main_fd_handler_add(0, ECORE_FD_READ,
                                        _cb_stdio_in_read, NULL,
                                        NULL, NULL);
+   e_system_inout_command_register("ping", _cb_ping, NULL);
 }
 
 void
@@ -152,7 +161,8 @@ e_system_inout_command_send(const char *cmd, const char *fmt, ...)
    Message_Head head;
    size_t len = strlen(cmd);
    int printed = 0;
-   ssize_t ret;
+   ssize_t ret, total;
+   struct iovec iov[2];
    va_list ap;
 
    if (len > 23)
@@ -180,21 +190,18 @@ e_system_inout_command_send(const char *cmd, const char *fmt, ...)
    memcpy(head.cmd, cmd, len);
    if (printed > 0) head.size = printed + 1;
    else head.size = 0;
-   ret = write(fd_supress, &head, sizeof(head));
-   if (ret != sizeof(head))
+   // one write per message so e never sees a head without its payload
+   iov[0].iov_base = &head;
+   iov[0].iov_len = sizeof(head);
+   iov[1].iov_base = buf;
+   iov[1].iov_len = buf ? head.size : 0;
+   total = sizeof(head) + iov[1].iov_len;
+   ret = writev(fd_supress, iov, 2);
+   if (ret != total)
      {
-        ERR("Write of command failed at %lli\n", (long long)ret);
+        ERR("Write of command failed at %lli/%lli\n", (long long)ret, (long long)total);
         abort();
      }
-   if ((buf) && (head.size > 0))
-     {
-        ret = write(fd_supress, buf, head.size);
-        if (ret != (ssize_t)head.size)
-          {
-             ERR("Write of command buffer failed at %lli/%llu\n", (long long)ret, (unsigned long long)head.size);
-             abort();
-          }
-     }
 end:
    if (buf != stack_buf) free(buf);
 }
@@ -103,6 +103,7 @@ e_modapi_init(E_Module *m)
    SET(type_register);
    SET(icon_theme_get);
    SET(fuzzy_match);
+   SET(fuzzy_match_mask);
    SET(util_exec_app);
    SET(util_url_escape);
    SET(util_url_unescape);
@@ -141,6 +142,9 @@ e_modapi_init(E_Module *m)
    /* cleanup every hour :) */
    cleanup_timer = ecore_timer_loop_add(3600, _cleanup_history, NULL);
 
+   /* nothing here is needed to show the desktop */
+   e_module_priority_set(m, E_MODULE_PRIORITY_AFTER_FIRST_FRAME);
+
    return m;
 }
 
@@ -229,6 +229,7 @@ void  evry_clear_input(Evry_Plugin *p);
 /* Evas_Object *evry_icon_mime_get(const char *mime, Evas *e); */
 Evas_Object *evry_icon_theme_get(const char *icon, Evas *e);
 int   evry_fuzzy_match(const char *str, const char *match);
+unsigned long long evry_fuzzy_match_mask(const char *str, int input);
 Eina_List *evry_fuzzy_match_sort(Eina_List *items);
 int   evry_util_exec_app(const Evry_Item *it_app, const Evry_Item *it_file);
 char *evry_util_url_escape(const char *string, int inlength);
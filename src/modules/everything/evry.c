@@ -104,6 +104,36 @@ evry_shutdown(void)
    return 1;
 }
 
+static void
+_evry_plugin_fetch_time_update(Evry_Plugin *p, Eina_Bool done)
+{
+   double t;
+
+   if (!(p->fetch_start > 0.0)) return;
+
+   t = ecore_time_get() - p->fetch_start;
+   if (done) p->fetch_start = 0.0;
+   if (!p->config) return;
+
+   p->config->fetch_time = t;
+   if (t > p->config->fetch_time_max)
+     p->config->fetch_time_max = t;
+}
+
+static int
+_evry_plugin_fetch(Evry_Plugin *p, const char *input, int async)
+{
+   int ret;
+
+   p->fetch_async = (p->async_fetch && (async || !p->sync_fetch));
+   p->fetch_start = ecore_time_get();
+   ret = p->fetch(p, input);
+   /* async plugins may still send their items later */
+   _evry_plugin_fetch_time_update(p, !p->fetch_async);
+
+   return ret;
+}
+
 static int
 _evry_aggregator_fetch(Evry_State *s)
 {
@@ -685,6 +715,8 @@ evry_plugin_update(Evry_Plugin *p, int action)
 
    if (action == EVRY_UPDATE_ADD)
      {
+        _evry_plugin_fetch_time_update(p, EINA_TRUE);
+
         /* clear marked items */
         if (s->sel_items)
           {
@@ -2868,7 +2900,7 @@ _evry_matches_update(Evry_Selector *sel, int async)
         EINA_LIST_FOREACH (s->cur_plugins, l, p)
           {
              p->request = s->request;
-             p->fetch(p, s->input);
+             _evry_plugin_fetch(p, s->input, async);
           }
         goto found;
      }
@@ -2897,9 +2929,9 @@ _evry_matches_update(Evry_Selector *sel, int async)
                   s->cur_plugins = eina_list_append(s->cur_plugins, p);
                   p->request = s->request;
                   if (len_inp == len)
-                    p->fetch(p, NULL);
+                    _evry_plugin_fetch(p, NULL, async);
                   else
-                    p->fetch(p, s->input + len);
+                    _evry_plugin_fetch(p, s->input + len, async);
                }
           }
         if (s->cur_plugins)
@@ -2931,7 +2963,7 @@ _evry_matches_update(Evry_Selector *sel, int async)
           goto next;
 
         /* dont wait for async plugin. use their current items */
-        if (!async && p->async_fetch && p->items)
+        if (!async && p->async_fetch && !p->sync_fetch && p->items)
           {
              s->cur_plugins = eina_list_append(s->cur_plugins, p);
              goto next;
@@ -2953,7 +2985,7 @@ _evry_matches_update(Evry_Selector *sel, int async)
                goto next;
           }
 
-        if (p->fetch(p, input))
+        if (_evry_plugin_fetch(p, input, async))
           {
 #ifdef CHECK_TIME
              DBG("fetch %s %f", p->name, ecore_time_get() - _evry_time);
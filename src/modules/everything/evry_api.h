@@ -3,7 +3,7 @@
 
 #include "evry_types.h"
 
-#define EVRY_API_VERSION     31
+#define EVRY_API_VERSION     33
 
 #define EVRY_ACTION_OTHER    0
 #define EVRY_ACTION_FINISHED 1
@@ -104,6 +104,8 @@ struct _Evry_API
   Evas_Object *(*icon_theme_get)(const char *icon, Evas *e);
 
   int   (*fuzzy_match)(const char *str, const char *match);
+  /* input: mask of the words fuzzy_match looks at, else of all of str */
+  unsigned long long (*fuzzy_match_mask)(const char *str, int input);
   int   (*util_exec_app)(const Evry_Item *it_app, const Evry_Item *it_file);
   char *(*util_url_escape)(const char *string, int inlength);
   char *(*util_url_unescape)(const char *string, int length);
@@ -14,6 +14,7 @@
 
 #define MAX_ITEMS 200
 #define MAX_EXE 50
+#define MATCH_THREAD_MIN 512
 #define DEFAULT_MATCH_PRIORITY 15
 #define PREFIX_MATCH_PRIORITY 11
 
@@ -22,6 +23,10 @@ typedef struct _Module_Config Module_Config;
 typedef struct _E_Exe         E_Exe;
 typedef struct _E_Exe_List    E_Exe_List;
 typedef struct _Item_Menu     Item_Menu;
+typedef struct _App_Entry     App_Entry;
+typedef struct _App_Index     App_Index;
+typedef struct _App_Match     App_Match;
+typedef struct _App_Match_Job App_Match_Job;
 
 struct _Plugin
 {
@@ -33,6 +38,13 @@ struct _Plugin
    Eina_List     *apps_hist;
    Eina_List     *menu_items;
 
+   /* apps_all prepared for matching, and the entries that could still
+    * match the last input so that typing on only rechecks those */
+   App_Index     *index;
+   Eina_Inarray  *index_cands;
+   const char    *index_input;
+   App_Match_Job *match_job;
+
    Eina_Hash     *added;
    Efreet_Menu   *menu;
 
@@ -66,6 +78,43 @@ struct _Item_Menu
    Efreet_Menu *menu;
 };
 
+struct _App_Entry
+{
+   Efreet_Desktop    *desktop;
+   char              *exec; /* without path and parameters */
+   char              *name;
+   unsigned long long exec_mask;
+   unsigned long long name_mask;
+};
+
+/* shared with match jobs, it does not change once built */
+struct _App_Index
+{
+   int           ref;
+   unsigned int  count;
+   App_Entry    *entries;
+};
+
+struct _App_Match
+{
+   unsigned int pos;
+   int          match;
+};
+
+/* matching of the index against input, run in a worker thread when there
+ * are many entries to check */
+struct _App_Match_Job
+{
+   Plugin          *plugin; /* NULL when no longer wanted */
+   Ecore_Thread    *thread;
+   App_Index       *index;
+   unsigned int    *prev; /* positions to check, all when NULL */
+   unsigned int     prev_count;
+   char            *input;
+   Eina_Inarray    *cands;
+   Eina_Inarray    *matches;
+};
+
 static const Evry_API *evry = NULL;
 static Evry_Module *evry_module = NULL;
 static Eina_List *handlers = NULL;
@@ -410,44 +459,212 @@ _item_desktop_add(Plugin *p, Efreet_Desktop *desktop, int match)
    EVRY_PLUGIN_ITEM_APPEND(p, app);
 }
 
+static char *
+_desktop_exec_get(const Efreet_Desktop *desktop)
+{
+   const char *exec, *end;
+
+   /* strip path and parameter */
+   exec = ecore_file_file_get(desktop->exec);
+   if (!exec) return NULL;
+   if ((end = strchr(exec, '%')) && ((end - exec) - 1 > 0))
+     return strndup(exec, (end - exec) - 1);
+   return strdup(exec);
+}
+
+static int
+_desktop_match(const char *name, const char *exec, const char *input)
+{
+   int m1, m2;
+
+   m1 = evry->fuzzy_match(exec, input);
+   m2 = evry->fuzzy_match(name, input);
+
+   if (!m1 || (m2 && m2 < m1)) m1 = m2;
+   return m1;
+}
+
 static void
 _desktop_list_add(Plugin *p, Eina_List *apps, const char *input)
 {
    Efreet_Desktop *desktop;
    Eina_List *l;
-   int m1, m2;
-   const char *exec, *end;
-   char buf[PATH_MAX];
+   char *exec;
+   int m1;
 
    EINA_LIST_FOREACH (apps, l, desktop)
      {
         if (eina_list_count(p->base.items) >= MAX_ITEMS) break;
 
-        m1 = m2 = 0;
+        m1 = 0;
 
         if (input)
           {
-             /* strip path and parameter */
-             exec = ecore_file_file_get(desktop->exec);
-             if ((exec) && (end = strchr(exec, '%')) &&
-                 ((end - exec) - 1 > 0))
-               {
-                  strncpy(buf, exec, (end - exec) - 1);
-                  buf[(end - exec) - 1] = '\0';
-                  m1 = evry->fuzzy_match(buf, input);
-               }
-             else
-               {
-                  m1 = evry->fuzzy_match(exec, input);
-               }
+             exec = _desktop_exec_get(desktop);
+             m1 = _desktop_match(desktop->name, exec, input);
+             free(exec);
+          }
+
+        if (!input || m1) _item_desktop_add(p, desktop, m1);
+     }
+}
+
+static void
+_desktop_index_unref(App_Index *idx)
+{
+   unsigned int i;
+
+   if (--idx->ref > 0) return;
+
+   for (i = 0; i < idx->count; i++)
+     {
+        free(idx->entries[i].exec);
+        free(idx->entries[i].name);
+     }
+   free(idx->entries);
+   free(idx);
+}
+
+static void
+_match_job_free(App_Match_Job *job)
+{
+   _desktop_index_unref(job->index);
+   free(job->prev);
+   free(job->input);
+   if (job->cands) eina_inarray_free(job->cands);
+   if (job->matches) eina_inarray_free(job->matches);
+   free(job);
+}
+
+static void
+_match_job_cancel(Plugin *p)
+{
+   App_Match_Job *job = p->match_job;
+
+   if (!job) return;
+   p->match_job = NULL;
+   job->plugin = NULL;
+   if (job->thread) ecore_thread_cancel(job->thread);
+}
+
+static void
+_desktop_index_free(Plugin *p)
+{
+   _match_job_cancel(p);
+
+   if (p->index) _desktop_index_unref(p->index);
+   p->index = NULL;
+   E_FREE_FUNC(p->index_cands, eina_inarray_free);
+   eina_stringshare_replace(&p->index_input, NULL);
+}
+
+static void
+_desktop_index_build(Plugin *p)
+{
+   Efreet_Desktop *desktop;
+   Eina_List *l;
+   App_Index *idx;
+   App_Entry *ae;
+
+   idx = E_NEW(App_Index, 1);
+   if (!idx) return;
+   idx->entries = E_NEW(App_Entry, eina_list_count(p->apps_all) + 1);
+   if (!idx->entries)
+     {
+        free(idx);
+        return;
+     }
+   idx->ref = 1;
+
+   EINA_LIST_FOREACH (p->apps_all, l, desktop)
+     {
+        ae = &idx->entries[idx->count++];
+        ae->desktop = desktop;
+        ae->exec = _desktop_exec_get(desktop);
+        if (desktop->name) ae->name = strdup(desktop->name);
+        ae->exec_mask = evry->fuzzy_match_mask(ae->exec, 0);
+        ae->name_mask = evry->fuzzy_match_mask(ae->name, 0);
+     }
+   p->index = idx;
+   p->index_cands = eina_inarray_new(sizeof(unsigned int), 64);
+}
+
+static App_Match_Job *
+_match_job_new(Plugin *p, const char *input)
+{
+   App_Match_Job *job;
+   unsigned int n;
+
+   job = E_NEW(App_Match_Job, 1);
+   job->plugin = p;
+   job->index = p->index;
+   job->index->ref++;
+   job->input = strdup(input);
+
+   /* input that extends the last one can only match a subset of what
+    * the last one could, so only recheck those */
+   if ((p->index_input) && (p->index_cands) &&
+       (!strncmp(input, p->index_input, strlen(p->index_input))))
+     {
+        n = eina_inarray_count(p->index_cands);
+        job->prev = malloc(sizeof(unsigned int) * (n + 1));
+        if (n) memcpy(job->prev, p->index_cands->members, sizeof(unsigned int) * n);
+        job->prev_count = n;
+     }
+
+   job->cands = eina_inarray_new(sizeof(unsigned int), 64);
+   job->matches = eina_inarray_new(sizeof(App_Match), 32);
+
+   return job;
+}
+
+static void
+_match_job_run(App_Match_Job *job, Ecore_Thread *thread)
+{
+   const App_Entry *ae;
+   unsigned long long mask;
+   unsigned int i, n, pos;
+   App_Match m;
+
+   mask = evry->fuzzy_match_mask(job->input, 1);
+   n = job->prev ? job->prev_count : job->index->count;
+
+   for (i = 0; i < n; i++)
+     {
+        if ((thread) && (!(i % 256)) && (ecore_thread_check(thread)))
+          return;
+
+        pos = job->prev ? job->prev[i] : i;
+        ae = &job->index->entries[pos];
+
+        if ((mask & ~ae->exec_mask) && (mask & ~ae->name_mask))
+          continue;
 
-             m2 = evry->fuzzy_match(desktop->name, input);
+        eina_inarray_push(job->cands, &pos);
 
-             if (!m1 || (m2 && m2 < m1)) m1 = m2;
+        if ((m.match = _desktop_match(ae->name, ae->exec, job->input)))
+          {
+             m.pos = pos;
+             eina_inarray_push(job->matches, &m);
           }
+     }
+}
 
-        if (!input || m1) _item_desktop_add(p, desktop, m1);
+static void
+_match_job_apply(Plugin *p, App_Match_Job *job)
+{
+   App_Match *m;
+
+   EINA_INARRAY_FOREACH (job->matches, m)
+     {
+        if (eina_list_count(p->base.items) >= MAX_ITEMS) break;
+        _item_desktop_add(p, job->index->entries[m->pos].desktop, m->match);
      }
+
+   if (p->index_cands) eina_inarray_free(p->index_cands);
+   p->index_cands = job->cands;
+   job->cands = NULL;
+   eina_stringshare_replace(&p->index_input, job->input);
 }
 
 static Eina_List *
@@ -593,6 +810,8 @@ _finish(Evry_Plugin *plugin)
    if ((!p->browse) && (p->menu))
      efreet_menu_free(p->menu);
 
+   _desktop_index_free(p);
+
    EINA_LIST_FREE (p->apps_all, desktop)
      efreet_desktop_free(desktop);
 
@@ -608,9 +827,9 @@ _finish(Evry_Plugin *plugin)
 }
 
 static int
-_fetch(Evry_Plugin *plugin, const char *input)
+_items_update(Plugin *p, const char *input, App_Match_Job *job)
 {
-   GET_PLUGIN(p, plugin);
+   Evry_Plugin *plugin = EVRY_PLUGIN(p);
    Eina_List *l;
    Evry_Item *it;
    History_Types *ht;
@@ -624,10 +843,7 @@ _fetch(Evry_Plugin *plugin, const char *input)
      {
         if (input)
           {
-             if (!p->apps_all)
-               p->apps_all = _desktop_list_get();
-
-             _desktop_list_add(p, p->apps_all, input);
+             if (job) _match_job_apply(p, job);
           }
         else
           {
@@ -685,6 +901,81 @@ _fetch(Evry_Plugin *plugin, const char *input)
    return EVRY_PLUGIN_HAS_ITEMS(p);
 }
 
+static void
+_match_thread_func(void *data, Ecore_Thread *thread)
+{
+   _match_job_run(data, thread);
+}
+
+static void
+_match_thread_end_func(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   App_Match_Job *job = data;
+   Plugin *p = job->plugin;
+
+   if (p)
+     {
+        p->match_job = NULL;
+        _items_update(p, job->input, job);
+        EVRY_PLUGIN_UPDATE(p, EVRY_UPDATE_ADD);
+     }
+   _match_job_free(job);
+}
+
+static void
+_match_thread_cancel_func(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   App_Match_Job *job = data;
+
+   if (job->plugin) job->plugin->match_job = NULL;
+   _match_job_free(job);
+}
+
+static int
+_fetch(Evry_Plugin *plugin, const char *input)
+{
+   GET_PLUGIN(p, plugin);
+   App_Match_Job *job = NULL;
+   Ecore_Thread *thread;
+   unsigned int n;
+   int ret;
+
+   _match_job_cancel(p);
+
+   if ((!p->browse) && (input))
+     {
+        if (!p->apps_all)
+          p->apps_all = _desktop_list_get();
+        if (!p->index)
+          _desktop_index_build(p);
+
+        if (p->index)
+          {
+             job = _match_job_new(p, input);
+             n = job->prev ? job->prev_count : job->index->count;
+
+             /* an update that can not wait gets the matches right away */
+             if ((plugin->fetch_async) && (n >= MATCH_THREAD_MIN))
+               {
+                  /* keep the current items until the matches are in */
+                  p->match_job = job;
+                  thread = ecore_thread_run(_match_thread_func,
+                                            _match_thread_end_func,
+                                            _match_thread_cancel_func, job);
+                  if (p->match_job == job) job->thread = thread;
+                  return EVRY_PLUGIN_HAS_ITEMS(p);
+               }
+             _match_job_run(job, NULL);
+          }
+     }
+
+   plugin->fetch_async = EINA_FALSE;
+   ret = _items_update(p, input, job);
+   if (job) _match_job_free(job);
+
+   return ret;
+}
+
 /***************************************************************************/
 
 static Evry_Plugin *
@@ -1149,6 +1440,8 @@ _plugins_init(const Evry_API *api)
                         _begin, _finish, _fetch);
    p->complete = &_complete;
    p->browse = &_browse;
+   p->async_fetch = EINA_TRUE;
+   p->sync_fetch = EINA_TRUE;
    p->config_path = eina_stringshare_ref(config_path);
    evry->plugin_register(p, EVRY_PLUGIN_SUBJECT, 1);
    _plugins = eina_list_append(_plugins, p);
@@ -1164,6 +1457,8 @@ _plugins_init(const Evry_API *api)
    p = EVRY_PLUGIN_BASE(N_("Applications"), _module_icon, EVRY_TYPE_APP,
                         _begin_mime, _finish, _fetch);
    p->complete = &_complete;
+   p->async_fetch = EINA_TRUE;
+   p->sync_fetch = EINA_TRUE;
    p->config_path = eina_stringshare_ref(config_path);
    evry->plugin_register(p, EVRY_PLUGIN_OBJECT, 1);
    _plugins = eina_list_append(_plugins, p);
@@ -16,6 +16,9 @@
 
 #define MAX_ITEMS                  10
 #define MAX_SHOWN                  300
+#define SCAN_BATCH                 64
+#define MIME_BATCH                 50
+#define SCAN_UPDATE_INTERVAL       0.1
 #define TERM_ACTION_DIR            "%s"
 
 #define CMD_NONE                   0
@@ -39,6 +42,8 @@
 
 typedef struct _Plugin        Plugin;
 typedef struct _Data          Data;
+typedef struct _Mime_Job      Mime_Job;
+typedef struct _Mime_Entry    Mime_Entry;
 typedef struct _Module_Config Module_Config;
 
 struct _Plugin
@@ -57,7 +62,9 @@ struct _Plugin
    Eina_Bool           sort_by_date;
 
    Ecore_Thread       *thread;
+   Ecore_Thread       *mime_thread;
    Ecore_File_Monitor *dir_mon;
+   int                 threads;
    int                 waiting_to_finish;
 };
 
@@ -70,7 +77,23 @@ struct _Data
    int        cnt;
    Eina_List *files;
    DIR       *dirp;
-   int        run_cnt;
+   double     filtered;
+};
+
+/* mime types are only looked up for files that would be shown */
+struct _Mime_Entry
+{
+   Evry_Item_File *file;
+   const char     *path;
+   const char     *mime;
+   Eina_Bool       dir;
+};
+
+struct _Mime_Job
+{
+   Plugin       *plugin;
+   Mime_Entry   *entries;
+   unsigned int  count;
 };
 
 struct _Module_Config
@@ -165,6 +188,8 @@ _scan_func(void *data, Ecore_Thread *thread)
    Eina_Iterator *ls;
    Eina_File_Direct_Info *info;
    Evry_Item_File *file;
+   Eina_List *batch = NULL;
+   int cnt = 0;
 
    if (!(ls = eina_file_stat_ls(d->directory)))
      return;
@@ -179,50 +204,63 @@ _scan_func(void *data, Ecore_Thread *thread)
         EVRY_ITEM(file)->label = strdup(info->path + info->name_start);
         EVRY_ITEM(file)->browseable = (info->type == EINA_FILE_DIR);
 
-        d->files = eina_list_append(d->files, file);
-        /* TODO dont append files in thread, run mime scan
-         * simultaneously. ecore_thread_feedback(thread, file); */
+        batch = eina_list_append(batch, file);
 
         if (ecore_thread_check(thread))
           break;
+
+        /* hand files to the main loop while scanning goes on */
+        if (++cnt >= SCAN_BATCH)
+          {
+             if (!ecore_thread_feedback(thread, batch))
+               break;
+             batch = NULL;
+             cnt = 0;
+          }
      }
 
    eina_iterator_free(ls);
+
+   if (batch)
+     {
+        if (ecore_thread_check(thread) || !ecore_thread_feedback(thread, batch))
+          d->files = batch;
+     }
 }
 
 static void
-_scan_mime_func(void *data, Ecore_Thread *thread)
+_mime_func(void *data, Ecore_Thread *thread)
 {
-   Data *d = data;
-   Evry_Item_File *file;
-   Eina_List *l;
-   int cnt = 0;
+   Mime_Job *job = data;
+   Mime_Entry *me;
+   unsigned int i;
 
-   EINA_LIST_FOREACH (d->files, l, file)
+   for (i = 0; i < job->count; i++)
      {
         if (ecore_thread_check(thread))
           break;
 
-        if ((file->mime = efreet_mime_type_get(file->path)))
+        me = &job->entries[i];
+        if ((me->mime = efreet_mime_type_get(me->path)))
           {
-             if (!strncmp(file->mime, "inode/", 6) &&
-                 ecore_file_is_dir(file->path))
-               EVRY_ITEM(file)->browseable = EINA_TRUE;
+             if (!strncmp(me->mime, "inode/", 6) &&
+                 ecore_file_is_dir(me->path))
+               me->dir = EINA_TRUE;
           }
         else
-          file->mime = _mime_unknown;
-
-        if (cnt++ > MAX_ITEMS * d->run_cnt) break;
+          me->mime = _mime_unknown;
      }
 }
 
+static void _mime_scan(Plugin *p, Eina_List *files);
+
 static int
 _files_filter(Plugin *p)
 {
    int match;
    int cnt = 0;
    Evry_Item *it;
-   Eina_List *l;
+   Eina_List *l, *pending = NULL;
    unsigned int len = p->input ? strlen(p->input) : 0;
 
    EVRY_PLUGIN_ITEMS_CLEAR(p);
@@ -245,43 +283,67 @@ _files_filter(Plugin *p)
         if (len && (match = evry->fuzzy_match(it->label, p->input)))
           {
              it->fuzzy_match = match;
-             if (!it->browseable)
-               it->priority = 1;
-             EVRY_PLUGIN_ITEM_APPEND(p, it);
-             cnt++;
           }
-        else if (len == 0)
+        else if (len != 0)
+          continue;
+
+        cnt++;
+
+        /* shown once its mime type is known */
+        if (!EVRY_FILE(it)->mime)
           {
-             if (!it->browseable)
-               it->priority = 1;
-             EVRY_PLUGIN_ITEM_APPEND(p, it);
-             cnt++;
+             pending = eina_list_append(pending, it);
+             continue;
           }
+
+        if (!it->browseable)
+          it->priority = 1;
+        EVRY_PLUGIN_ITEM_APPEND(p, it);
+     }
+
+   if (pending)
+     {
+        if (!p->mime_thread)
+          _mime_scan(p, pending);
+        eina_list_free(pending);
      }
+
    return cnt;
 }
 
 static void
-_scan_cancel_func(void *data, Ecore_Thread *thread EINA_UNUSED)
+_scan_files_free(Eina_List *files)
 {
-   Data *d = data;
-   Plugin *p = d->plugin;
    Evry_Item_File *file;
 
-   /* EINA_LIST_FREE(p->files, file)
-    *   EVRY_ITEM_FREE(file); */
-
-   EINA_LIST_FREE (d->files, file)
+   EINA_LIST_FREE (files, file)
      {
         if (file->base.label) free((char *)(file->base.label));
         if (file->path) free((char *)file->path);
         E_FREE(file);
      }
+}
 
-   p->thread = NULL;
+static void
+_thread_done(Plugin *p)
+{
+   p->threads--;
 
-   if (p->waiting_to_finish)
+   if ((p->waiting_to_finish) && (!p->threads))
      E_FREE(p);
+}
+
+static void
+_scan_cancel_func(void *data, Ecore_Thread *thread)
+{
+   Data *d = data;
+   Plugin *p = d->plugin;
+
+   _scan_files_free(d->files);
+
+   if (p->thread == thread)
+     p->thread = NULL;
+   _thread_done(p);
 
    free(d->directory);
    E_FREE(d);
@@ -323,6 +385,9 @@ _cache_dir_add(Eina_List *files)
      {
         GET_FILE(file, item);
 
+        /* mime type not looked up yet */
+        if (!file->mime) continue;
+
         if (!(item->hi) &&
             (hi = evry->history_item_add(item, NULL, NULL)))
           {
@@ -364,74 +429,165 @@ _file_add(Plugin *p, Evry_Item *item)
 }
 
 static void
-_scan_end_func(void *data, Ecore_Thread *thread EINA_UNUSED)
+_scan_notify_func(void *data, Ecore_Thread *thread, void *msg_data)
 {
    Data *d = data;
    Plugin *p = d->plugin;
+   Eina_List *files = msg_data;
    Evry_Item *item;
-   Evry_Item_File *file;
-   Eina_List *l, *ll;
    History_Types *ht = NULL;
+   double t;
+
+   if (ecore_thread_check(thread))
+     {
+        _scan_files_free(files);
+        return;
+     }
 
    if (_conf->cache_dirs)
      ht = evry->history_types_get(EVRY_TYPE_FILE);
 
-   if (!d->run_cnt) /* _scan_func finished */
+   EINA_LIST_FREE (files, item)
      {
-        EINA_LIST_FOREACH_SAFE (d->files, l, ll, item)
-          {
-             GET_FILE(browse, item);
+        GET_FILE(browse, item);
 
-             if (item->browseable)
-               browse->mime = _mime_dir;
-             else if (ht)
-               _cache_mime_get(ht, browse);
+        if (item->browseable)
+          browse->mime = _mime_dir;
+        else if (ht)
+          _cache_mime_get(ht, browse);
 
-             if (browse->mime)
-               {
-                  d->files = eina_list_remove_list(d->files, l);
-                  _file_add(p, item);
-               }
-          }
+        _file_add(p, item);
+     }
+
+   /* match what is there so far, but not for every batch */
+   t = ecore_time_get();
+   if (t - d->filtered < SCAN_UPDATE_INTERVAL) return;
+   d->filtered = t;
+
+   p->files = eina_list_sort(p->files, -1, _cb_sort);
+   _files_filter(p);
+   EVRY_PLUGIN_UPDATE(p, EVRY_UPDATE_ADD);
+}
+
+static void
+_scan_end_func(void *data, Ecore_Thread *thread)
+{
+   Data *d = data;
+   Plugin *p = d->plugin;
 
-        /* sort files by name for mimetypes scan */
-        if (d->files)
-          d->files = eina_list_sort(d->files, -1, _cb_sort);
+   if (p->thread == thread)
+     p->thread = NULL;
+
+   if (!ecore_thread_check(thread))
+     {
+        if (_conf->cache_dirs && !(p->command == CMD_SHOW_HIDDEN))
+          _cache_dir_add(p->files);
+
+        p->files = eina_list_sort(p->files, -1, _cb_sort);
+
+        _files_filter(p);
+
+        EVRY_PLUGIN_UPDATE(p, EVRY_UPDATE_ADD);
      }
-   else /* _scan_mime_func finished */
+
+   _scan_files_free(d->files);
+   free(d->directory);
+   E_FREE(d);
+
+   _thread_done(p);
+}
+
+static void
+_mime_job_free(Mime_Job *job)
+{
+   unsigned int i;
+
+   for (i = 0; i < job->count; i++)
+     EVRY_ITEM_FREE(job->entries[i].file);
+   free(job->entries);
+   free(job);
+}
+
+static void
+_mime_end_func(void *data, Ecore_Thread *thread)
+{
+   Mime_Job *job = data;
+   Plugin *p = job->plugin;
+   Mime_Entry *me;
+   unsigned int i;
+
+   if (p->mime_thread == thread)
+     p->mime_thread = NULL;
+
+   if (!ecore_thread_check(thread))
      {
-        EINA_LIST_FREE (d->files, file)
+        for (i = 0; i < job->count; i++)
           {
-             if (!file->mime) break;
-             _file_add(p, (Evry_Item *)file);
+             me = &job->entries[i];
+             if (me->file->mime) continue;
+
+             me->file->mime = eina_stringshare_add(me->mime);
+             if (me->dir)
+               EVRY_ITEM(me->file)->browseable = EINA_TRUE;
+             eina_stringshare_replace(&EVRY_ITEM(me->file)->context, me->file->mime);
           }
-     }
 
-   if (d->files) /* scan mimetypes */
-     {
-        d->run_cnt++;
-        p->thread = ecore_thread_run(_scan_mime_func,
-                                     _scan_end_func,
-                                     _scan_cancel_func, d);
+        _files_filter(p);
 
-        /* wait for first mime scan to finish */
-        if (d->run_cnt == 1) return;
+        EVRY_PLUGIN_UPDATE(p, EVRY_UPDATE_ADD);
      }
-   else /* finished all file/mime scan */
-     {
-        free(d->directory);
-        E_FREE(d);
-        p->thread = NULL;
 
-        if (_conf->cache_dirs && !(p->command == CMD_SHOW_HIDDEN))
-          _cache_dir_add(p->files);
-     }
+   _mime_job_free(job);
 
-   p->files = eina_list_sort(p->files, -1, _cb_sort);
+   _thread_done(p);
+}
 
-   _files_filter(p);
+static void
+_mime_cancel_func(void *data, Ecore_Thread *thread)
+{
+   Mime_Job *job = data;
+   Plugin *p = job->plugin;
 
-   EVRY_PLUGIN_UPDATE(p, EVRY_UPDATE_ADD);
+   if (p->mime_thread == thread)
+     p->mime_thread = NULL;
+
+   _mime_job_free(job);
+
+   _thread_done(p);
+}
+
+static void
+_mime_scan(Plugin *p, Eina_List *files)
+{
+   Mime_Job *job;
+   Evry_Item_File *file;
+   Eina_List *l;
+   Ecore_Thread *thread;
+
+   job = E_NEW(Mime_Job, 1);
+   if (!job) return;
+   job->plugin = p;
+   job->entries = E_NEW(Mime_Entry, MIME_BATCH);
+   if (!job->entries)
+     {
+        free(job);
+        return;
+     }
+
+   /* the rest follows when this batch is shown */
+   EINA_LIST_FOREACH (files, l, file)
+     {
+        if (job->count >= MIME_BATCH) break;
+        evry->item_ref(EVRY_ITEM(file));
+        job->entries[job->count].file = file;
+        job->entries[job->count].path = file->path;
+        job->count++;
+     }
+
+   p->threads++;
+   thread = ecore_thread_run(_mime_func, _mime_end_func, _mime_cancel_func, job);
+   /* NULL when it already ran in the main loop */
+   if (thread) p->mime_thread = thread;
 }
 
 static void
@@ -492,11 +648,16 @@ static void
 _read_directory(Plugin *p)
 {
    Data *d = E_NEW(Data, 1);
+   Ecore_Thread *thread;
+
    d->plugin = p;
    d->directory = strdup(p->directory);
-   d->run_cnt = 0;
 
-   p->thread = ecore_thread_run(_scan_func, _scan_end_func, _scan_cancel_func, d);
+   p->threads++;
+   thread = ecore_thread_feedback_run(_scan_func, _scan_notify_func,
+                                      _scan_end_func, _scan_cancel_func,
+                                      d, EINA_FALSE);
+   if (thread) p->thread = thread;
 
    if (p->dir_mon)
      ecore_file_monitor_del(p->dir_mon);
@@ -614,6 +775,9 @@ _free_files(Plugin *p)
    if (p->thread)
      ecore_thread_cancel(p->thread);
    p->thread = NULL;
+   if (p->mime_thread)
+     ecore_thread_cancel(p->mime_thread);
+   p->mime_thread = NULL;
 
    EINA_LIST_FREE (p->files, file)
      EVRY_ITEM_FREE(file);
@@ -631,12 +795,12 @@ _finish(Evry_Plugin *plugin)
    IF_RELEASE(p->input);
    IF_RELEASE(p->directory);
 
-   if (p->thread)
-     p->waiting_to_finish = 1;
-
    _free_files(p);
 
-   if (!p->waiting_to_finish)
+   /* freed by the last thread to end */
+   if (p->threads)
+     p->waiting_to_finish = 1;
+   else
      E_FREE(p);
 }
 
@@ -69,6 +69,7 @@ evry_plugin_new(Evry_Plugin *base, const char *name, const char *label,
    p->fetch = fetch;
 
    p->async_fetch = EINA_FALSE;
+   p->sync_fetch = EINA_FALSE;
    p->history = EINA_TRUE;
 
    return p;
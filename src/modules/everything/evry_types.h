@@ -141,6 +141,8 @@ struct _Evry_Plugin
   Plugin_Config *config;
   unsigned int request;
   Evry_State *state;
+  /* when the pending fetch was started */
+  double fetch_start;
 
   /* identifier */
   const char *name;
@@ -190,10 +192,20 @@ struct _Evry_Plugin
   /* optional: set type which the plugin can handle in 'begin' */
   Evry_Type input_type;
 
-  /* optional: whether the plugin uses evry_async_update to add new items */
+  /* optional: whether the plugin uses evry_async_update to add new items,
+     e.g. when matching runs in a thread. the time until the first update
+     after fetch is shown as the plugins' latency */
   /* default FALSE */
   Eina_Bool async_fetch;
 
+  /* optional: for async_fetch plugins that can also answer within fetch.
+     they are then queried by updates that can not wait for items, too.
+     fetch_async is set when the current fetch may answer later; clear
+     it when the items were added right away */
+  /* default FALSE */
+  Eina_Bool sync_fetch;
+  Eina_Bool fetch_async;
+
   /* optional: request items to be remembered for usage statistic */
   /* default TRUE */
   Eina_Bool history;
@@ -248,6 +260,10 @@ struct _Plugin_Config
   Evry_Plugin *plugin;
 
   Eina_List *plugins;
+
+  /* do not set! last and slowest time from fetch to items */
+  double fetch_time;
+  double fetch_time_max;
 };
 
 struct _Evry_View
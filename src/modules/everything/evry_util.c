@@ -263,6 +263,35 @@ evry_fuzzy_match(const char *str, const char *match)
    return sum;
 }
 
+/* every character of the first MAX_WORDS words of a match must appear in
+ * str for evry_fuzzy_match() to succeed, so a string whose mask lacks a
+ * bit of the input mask can be skipped without matching. non-ascii
+ * characters are left out as matching only compares their first byte */
+unsigned long long
+evry_fuzzy_match_mask(const char *str, int input)
+{
+   unsigned long long mask = 0;
+   unsigned int words = 0;
+   const char *p;
+
+   if (!str) return 0;
+
+   for (p = str; *p; p++)
+     {
+        if (isspace(*p))
+          {
+             if ((input) && (p > str) && (!isspace(p[-1])) &&
+                 (++words >= MAX_WORDS))
+               break;
+             continue;
+          }
+        if ((unsigned char)*p >= 0x80) continue;
+        mask |= 1ULL << (tolower(*p) & 63);
+     }
+
+   return mask;
+}
+
 static int
 _evry_fuzzy_match_sort_cb(const void *data1, const void *data2)
 {
@@ -57,10 +57,33 @@ _cb_key_down(Evry_View *v, const Ecore_Event_Key *ev)
    return 1;
 }
 
+static void
+_latency_append(Eina_Strbuf *buf, Eina_List *confs, const char *title)
+{
+   Plugin_Config *pc;
+   Eina_List *l;
+   Eina_Bool first = EINA_TRUE;
+
+   EINA_LIST_FOREACH (confs, l, pc)
+     {
+        if (!(pc->fetch_time_max > 0.0)) continue;
+
+        if (first)
+          {
+             eina_strbuf_append_printf(buf, "<ps/>  <hilight>%s</hilight><ps/>", title);
+             first = EINA_FALSE;
+          }
+        eina_strbuf_append_printf(buf, _("    %s: %.1f ms (slowest %.1f ms)<ps/>"),
+                                  _(pc->name), pc->fetch_time * 1000.0,
+                                  pc->fetch_time_max * 1000.0);
+     }
+}
+
 static Evry_View *
 _view_create(Evry_View *v, const Evry_State *s EINA_UNUSED, Evas_Object *swallow)
 {
    Evas_Object *o;
+   Eina_Strbuf *buf;
    int mw, mh;
 
    char *text =
@@ -94,7 +117,14 @@ _view_create(Evry_View *v, const Evry_State *s EINA_UNUSED, Evas_Object *swallow
    e_theme_edje_object_set(o, "base/theme/widgets",
                            "e/modules/everything/textblock");
 
-   edje_object_part_text_set(o, "e.textblock.text", text);
+   /* time plugins took to deliver items for the last input */
+   buf = eina_strbuf_new();
+   eina_strbuf_append(buf, text);
+   _latency_append(buf, evry_conf->conf_subjects, _("Subject plugin latency"));
+   _latency_append(buf, evry_conf->conf_actions, _("Action plugin latency"));
+   _latency_append(buf, evry_conf->conf_objects, _("Object plugin latency"));
+   edje_object_part_text_set(o, "e.textblock.text", eina_strbuf_string_get(buf));
+   eina_strbuf_free(buf);
    elm_box_pack_start(v->o_list, o);
    edje_object_size_min_calc(o, &mw, &mh);
    E_WEIGHT(o, 1, 0);
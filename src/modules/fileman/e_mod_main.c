@@ -88,6 +88,9 @@ e_modapi_init(E_Module *m)
 
    e_fwin_nav_init();
 
+   /* desktop icons can follow once the desktop is up */
+   e_module_priority_set(m, E_MODULE_PRIORITY_AFTER_FIRST_FRAME);
+
    return m;
 }
 
@@ -91,6 +91,7 @@ struct _IBar_Icon
    Eina_Bool       not_in_order E_BITFIELD;
    Eina_Bool       menu_grabbed E_BITFIELD;
    Eina_Bool       starting E_BITFIELD;
+   Eina_Bool       stale E_BITFIELD;
 };
 
 static IBar        *_ibar_new(Evas_Object *parent, Instance *inst);
@@ -99,6 +100,7 @@ static void         _ibar_cb_empty_mouse_down(void *data, Evas *e, Evas_Object *
 static void         _ibar_empty_handle(IBar *b);
 static void         _ibar_instance_watch(void *data, E_Exec_Instance *inst, E_Exec_Watch_Type type);
 static void         _ibar_fill(IBar *b);
+static void         _ibar_refill(IBar *b);
 static void         _ibar_empty(IBar *b);
 static void         _ibar_orient_set(IBar *b, int horizontal);
 static void         _ibar_resize_handle(IBar *b);
@@ -217,10 +219,7 @@ _ibar_order_refresh(IBar *b, const char *path)
         io = b->io = _ibar_order_new(b, path);
      }
    EINA_INLIST_FOREACH(io->bars, bar)
-     {
-        _ibar_empty(bar);
-        _ibar_fill(bar);
-     }
+     _ibar_refill(bar);
 }
 
 static void
@@ -596,6 +595,114 @@ _ibar_fill(IBar *b)
    evas_object_size_hint_max_set(b->o_box, w, h);
 }
 
+/* takes over a stale icon for desktop, moved to the end of the bar, if
+ * it still shows the same thing */
+static IBar_Icon *
+_ibar_icon_reuse(IBar *b, Efreet_Desktop *desktop, Eina_Bool notinorder)
+{
+   IBar_Icon *ic;
+   Evas_Object *box;
+
+   ic = eina_hash_find(b->icon_hash, _desktop_name_get(desktop));
+   if ((!ic) || (!ic->stale)) return NULL;
+   if ((ic->app != desktop) || (ic->not_in_order != notinorder))
+     {
+        _ibar_icon_free(ic);
+        return NULL;
+     }
+   ic->stale = EINA_FALSE;
+   b->icons = eina_inlist_demote(b->icons, EINA_INLIST_GET(ic));
+   box = notinorder ? b->o_outerbox : b->o_box;
+   elm_box_unpack(box, ic->o_holder);
+   elm_box_pack_end(box, ic->o_holder);
+   return ic;
+}
+
+/* like _ibar_empty() + _ibar_fill(), but icons that are still wanted are
+ * kept and only moved into place - just apps new to the bar get new edje
+ * objects */
+static void
+_ibar_refill(IBar *b)
+{
+   IBar_Icon *ic;
+   Eina_Inlist *l;
+   int w, h;
+
+   EINA_INLIST_FOREACH(b->icons, ic)
+     ic->stale = EINA_TRUE;
+
+   if (b->io->eo)
+     {
+        Efreet_Desktop *desktop;
+        const Eina_List *ll;
+
+        EINA_LIST_FOREACH(b->io->eo->desktops, ll, desktop)
+          {
+             const Eina_List *lll;
+
+             if (_ibar_icon_reuse(b, desktop, 0)) continue;
+             ic = _ibar_icon_new(b, desktop, 0);
+             lll = e_exec_desktop_instances_find(desktop);
+             if (lll)
+               {
+                  ic->exes = eina_list_clone(lll);
+                  _ibar_icon_signal_emit(ic, "e,state,on", "e");
+               }
+          }
+     }
+   if (!b->inst->ci->dont_add_nonorder)
+     {
+        const Eina_Hash *execs = e_exec_instances_get();
+        Eina_Iterator *it;
+        const Eina_List *ll, *lll;
+        E_Exec_Instance *exe;
+
+        it = eina_hash_iterator_data_new(execs);
+        EINA_ITERATOR_FOREACH(it, ll)
+          {
+             EINA_LIST_FOREACH(ll, lll, exe)
+               {
+                  E_Client *ec;
+                  Eina_List *llll;
+                  Eina_Bool skip = EINA_TRUE;
+
+                  if (!exe->desktop) continue;
+                  EINA_LIST_FOREACH(exe->clients, llll, ec)
+                    if (!ec->netwm.state.skip_taskbar)
+                      {
+                         skip = EINA_FALSE;
+                         break;
+                      }
+                  if (skip) continue;
+                  ic = eina_hash_find(b->icon_hash, _desktop_name_get(exe->desktop));
+                  if ((!ic) || (ic->stale))
+                    ic = _ibar_icon_reuse(b, exe->desktop, 1);
+                  if (ic)
+                    {
+                       if (!eina_list_data_find(ic->exes, exe))
+                         ic->exes = eina_list_append(ic->exes, exe);
+                       continue;
+                    }
+                  _ibar_sep_create(b);
+                  _ibar_icon_notinorder_new(b, exe);
+               }
+          }
+        eina_iterator_free(it);
+     }
+
+   /* everything still wanted was moved behind these */
+   EINA_INLIST_FOREACH_SAFE(b->icons, l, ic)
+     if (ic->stale) _ibar_icon_free(ic);
+   if (!b->not_in_order_count)
+     E_FREE_FUNC(b->o_sep, evas_object_del);
+
+   _ibar_empty_handle(b);
+   _ibar_resize_handle(b);
+   if (!b->inst->gcc) return;
+   evas_object_size_hint_min_get(b->o_box, &w, &h);
+   evas_object_size_hint_max_set(b->o_box, w, h);
+}
+
 static void
 _ibar_empty(IBar *b)
 {
@@ -999,12 +1106,13 @@ _ibar_cb_app_change(void *data, E_Order *eo EINA_UNUSED)
 
    EINA_INLIST_FOREACH(io->bars, b)
      {
-        _ibar_empty(b);
         if (b->inst)
           {
-             _ibar_fill(b);
+             _ibar_refill(b);
              if (b->inst->gcc) _gc_orient(b->inst->gcc, -1);
           }
+        else
+          _ibar_empty(b);
      }
 }
 
@@ -1999,8 +2107,7 @@ _ibar_cb_drag_finished(E_Drag *drag, int dropped)
    if (!i) return;
    if (!dropped)
      {
-        _ibar_empty(i);
-        _ibar_fill(i);
+        _ibar_refill(i);
         _ibar_resize_handle(i);
      }
 }
@@ -444,7 +444,7 @@ _gc_id_new(const E_Gadcon_Client_Class *client_class EINA_UNUSED)
 }
 
 E_API void *
-e_modapi_init(E_Module *m EINA_UNUSED)
+e_modapi_init(E_Module *m)
 {
    char buf[4096];
 
@@ -474,6 +474,9 @@ e_modapi_init(E_Module *m EINA_UNUSED)
 
    e_gadcon_provider_register(&_gadcon_class);
 
+   /* backend probing is slow and the gadget can show up late */
+   e_module_priority_set(m, E_MODULE_PRIORITY_AFTER_FIRST_FRAME);
+
    return m;
 }
 
@@ -30,6 +30,7 @@ struct _E_Config_Dialog_Data
       Eina_List   *popup_list, *urgent_list;
    } gui;
    int flip_desk, show_desk_names;
+   int mirror_fps;
    E_Config_Dialog *cfd;
 };
 
@@ -103,6 +104,7 @@ _fill_data(E_Config_Dialog_Data *cfdata)
    cfdata->btn.desk = pager_config->btn_desk;
    cfdata->flip_desk = pager_config->flip_desk;
    cfdata->show_desk_names = pager_config->show_desk_names;
+   cfdata->mirror_fps = pager_config->mirror_fps;
 }
 
 static void
@@ -185,6 +187,11 @@ _adv_create(E_Config_Dialog *cfd, Evas *evas, E_Config_Dialog_Data *cfdata)
    ow = e_widget_check_add(evas, _("Always show desktop names"),
                            &(cfdata->show_desk_names));
    e_widget_list_object_append(ol, ow, 1, 0, 0.5);
+   ow = e_widget_label_add(evas, _("Window preview updates (0 for live)"));
+   e_widget_list_object_append(ol, ow, 1, 0, 0.5);
+   ow = e_widget_slider_add(evas, 1, 0, _("%.0f per second"), 0.0, 60.0, 1.0, 0, NULL,
+                            &(cfdata->mirror_fps), 100);
+   e_widget_list_object_append(ol, ow, 1, 0, 0.5);
 
 #if 0
    ow = e_widget_label_add(evas, _("Select and Slide button"));
@@ -298,6 +305,7 @@ _adv_apply(E_Config_Dialog *cfd EINA_UNUSED, E_Config_Dialog_Data *cfdata)
    pager_config->btn_drag = cfdata->btn.drag;
    pager_config->btn_noplace = cfdata->btn.noplace;
    pager_config->btn_desk = cfdata->btn.desk;
+   pager_config->mirror_fps = cfdata->mirror_fps;
    _pager_cb_config_updated();
    e_config_save_queue();
    return 1;
@@ -322,6 +330,7 @@ _adv_check_changed(E_Config_Dialog *cfd EINA_UNUSED, E_Config_Dialog_Data *cfdat
    if (pager_config->btn_drag != cfdata->btn.drag) return 1;
    if (pager_config->btn_noplace != cfdata->btn.noplace) return 1;
    if (pager_config->btn_desk != cfdata->btn.desk) return 1;
+   if ((int)pager_config->mirror_fps != cfdata->mirror_fps) return 1;
 
    return 0;
 }
@@ -510,6 +510,8 @@ _pager_desk_new(Pager *p, E_Desk *desk, int xpos, int ypos, Eina_Bool invert)
    evas_object_show(o);
 
    pd->o_layout = e_deskmirror_add(desk, 1, 0);
+   if (pager_config->mirror_fps)
+     e_deskmirror_mirror_throttle_set(pd->o_layout, 1.0 / pager_config->mirror_fps);
    evas_object_smart_callback_add(pd->o_layout, "mirror_add", (Evas_Smart_Cb)_pager_cb_mirror_add, pd);
 
    l = e_deskmirror_mirror_list(pd->o_layout);
@@ -998,6 +1000,8 @@ _pager_cb_config_updated(void)
             edje_object_signal_emit(pd->o_desk, "e,name,show", "e");
           else
             edje_object_signal_emit(pd->o_desk, "e,name,hide", "e");
+          e_deskmirror_mirror_throttle_set(pd->o_layout, pager_config->mirror_fps ?
+                                           1.0 / pager_config->mirror_fps : 0.0);
        }
 }
 
@@ -2113,6 +2117,7 @@ e_modapi_init(E_Module *m EINA_UNUSED)
    E_CONFIG_VAL(D, T, flip_desk, UCHAR);
    E_CONFIG_VAL(D, T, plain, UCHAR);
    E_CONFIG_VAL(D, T, permanent_plain, UCHAR);
+   E_CONFIG_VAL(D, T, mirror_fps, UINT);
 
    pager_config = e_config_domain_load("module.pager", conf_edd);
 
@@ -2134,6 +2139,7 @@ e_modapi_init(E_Module *m EINA_UNUSED)
         pager_config->flip_desk = 0;
         pager_config->plain = 0;
         pager_config->permanent_plain = 0;
+        pager_config->mirror_fps = 4;
      }
    E_CONFIG_LIMIT(pager_config->popup, 0, 1);
    E_CONFIG_LIMIT(pager_config->popup_speed, 0.1, 10.0);
@@ -2150,6 +2156,7 @@ e_modapi_init(E_Module *m EINA_UNUSED)
    E_CONFIG_LIMIT(pager_config->btn_desk, 0, 32);
    E_CONFIG_LIMIT(pager_config->plain, 0, 1);
    E_CONFIG_LIMIT(pager_config->permanent_plain, 0, 1);
+   E_CONFIG_LIMIT(pager_config->mirror_fps, 0, 60);
 
    p = e_module_find("pager_plain");
    if (p && p->enabled)
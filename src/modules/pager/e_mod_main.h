@@ -21,6 +21,7 @@ struct _Config
       unsigned int flip_desk;
       unsigned int plain;
       unsigned int permanent_plain;
+      unsigned int mirror_fps;
 };
 
 #define PAGER_RESIZE_NONE 0
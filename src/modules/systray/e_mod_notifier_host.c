@@ -35,6 +35,8 @@ systray_notifier_item_free(Notifier_Item *item)
         host_inst->ii_list = eina_inlist_remove(host_inst->ii_list,
                                                 EINA_INLIST_GET(ii));
         evas_object_del(ii->icon);
+        eina_stringshare_del(ii->file);
+        eina_stringshare_del(ii->theme_name);
         free(ii);
         systray_size_updated(host_inst->inst);
      }
@@ -65,8 +67,71 @@ systray_notifier_item_free(Notifier_Item *item)
    free(item);
 }
 
+typedef struct _Notifier_Icon_Dir
+{
+   Eina_Stringshare *theme; // icon theme the cached files were found with
+   Eina_Hash *files; // icon name -> file, "" if there is none
+   Eina_Hash *monitors; // directory -> Ecore_File_Monitor
+} Notifier_Icon_Dir;
+
 static void
-image_load(const char *name, const char *path, uint32_t *imgdata, int w, int h, Evas_Object *image)
+_icon_dir_free(Notifier_Icon_Dir *id)
+{
+   eina_hash_free(id->files);
+   eina_hash_free(id->monitors);
+   eina_stringshare_del(id->theme);
+   free(id);
+}
+
+static void
+_icon_dir_monitor_cb(void *data, Ecore_File_Monitor *em, Ecore_File_Event event EINA_UNUSED, const char *path EINA_UNUSED)
+{
+   Notifier_Icon_Dir *id = data;
+   Instance_Notifier_Host *host_inst;
+   Notifier_Item_Icon *ii;
+   Notifier_Item *item;
+   const char *dir;
+   size_t len;
+   Eina_Bool reload = EINA_FALSE;
+
+   eina_hash_free_buckets(id->files);
+   /* a file rewritten in place keeps its path, so icons showing a file
+    * below this directory have to load it again */
+   dir = ecore_file_monitor_path_get(em);
+   len = strlen(dir);
+   EINA_INLIST_FOREACH(ctx->instances, host_inst)
+     {
+        EINA_INLIST_FOREACH(host_inst->ii_list, ii)
+          {
+             if ((!ii->file) || strncmp(ii->file, dir, len) ||
+                 (ii->file[len] != '/'))
+               continue;
+             eina_stringshare_replace(&ii->file, NULL);
+             reload = EINA_TRUE;
+          }
+     }
+   if (!reload) return;
+   EINA_INLIST_FOREACH(ctx->item_list, item)
+     systray_notifier_item_update(item);
+}
+
+/* every directory a lookup looked at is watched, so any file or directory
+ * appearing or vanishing below IconThemePath drops the cached results
+ */
+static Eina_Bool
+_icon_dir_check(Notifier_Icon_Dir *id, const char *dir)
+{
+   Ecore_File_Monitor *mon;
+
+   if (!ecore_file_is_dir(dir)) return EINA_FALSE;
+   if (eina_hash_find(id->monitors, dir)) return EINA_TRUE;
+   mon = ecore_file_monitor_add(dir, _icon_dir_monitor_cb, id);
+   if (mon) eina_hash_add(id->monitors, dir, mon);
+   return EINA_TRUE;
+}
+
+static const char *
+_icon_dir_file_find(Notifier_Icon_Dir *id, const char *path, const char *name)
 {
    const char **ext, *exts[] =
    {
@@ -74,72 +139,151 @@ image_load(const char *name, const char *path, uint32_t *imgdata, int w, int h,
       ".jpg",
       NULL
    };
-   printf("SYSTRAY: load image name=[%s] path=[%s] imgdata=[%p] size=[%ix%i]\n", name, path, imgdata, w, h);
-   if (path && path[0] && name)
+   const char **theme, *themes[] =
      {
-        char buf[PATH_MAX];
-        const char **theme, *themes[] =
-          {
-             e_config->icon_theme,
-             "hicolor",
+        e_config->icon_theme,
+        "hicolor",
 // hmm sometimes this is there
 //             "emblems",
-             NULL
+        NULL
+     };
+   const char **cat, *cats[] =
+     {
+        "status",
+        "apps",
+        NULL
+     };
+   char buf[PATH_MAX];
+
+   if (!_icon_dir_check(id, path)) return NULL;
+   for (theme = themes; *theme; theme++)
+     {
+        unsigned int *i, sizes[] =
+          {
+             512, 256, 192, 128, 96, 72, 64, 48, 40, 36, 32, 24, 22, 16, 0
           };
 
-        for (theme = themes; *theme; theme++)
+        snprintf(buf, sizeof(buf), "%s/%s", path, *theme);
+        if (!_icon_dir_check(id, buf)) continue;
+        for (i = sizes; *i; i++)
           {
-             unsigned int *i, sizes[] =
-               {
-                  512, 256, 192, 128, 96, 72, 64, 48, 40, 36, 32, 24, 22, 16, 0
-               };
+             Eina_Bool cat_dirs[2];
 
-             snprintf(buf, sizeof(buf), "%s/%s", path, *theme);
-             if (!ecore_file_is_dir(buf)) continue;
-             for (i = sizes; *i; i++)
+             snprintf(buf, sizeof(buf), "%s/%s/%ux%u", path, *theme, *i, *i);
+             if (!_icon_dir_check(id, buf)) continue;
+             for (cat = cats; *cat; cat++)
+               {
+                  snprintf(buf, sizeof(buf), "%s/%s/%ux%u/%s", path, *theme, *i, *i, *cat);
+                  cat_dirs[cat - cats] = _icon_dir_check(id, buf);
+               }
+             for (ext = exts; *ext; ext++)
                {
-                  snprintf(buf, sizeof(buf), "%s/%s/%ux%u", path, *theme, *i, *i);
-                  if (!ecore_file_is_dir(buf)) continue;
-                  for (ext = exts; *ext; ext++)
+                  for (cat = cats; *cat; cat++)
                     {
-                       snprintf(buf, sizeof(buf), "%s/%s/%ux%u/status/%s%s", path, *theme, *i, *i, name, *ext);
+                       if (!cat_dirs[cat - cats]) continue;
+                       snprintf(buf, sizeof(buf), "%s/%s/%ux%u/%s/%s%s", path, *theme, *i, *i, *cat, name, *ext);
                        if (ecore_file_exists(buf))
-                         {
-                            e_icon_file_set(image, buf);
-                            return;
-                         }
-                       snprintf(buf, sizeof(buf), "%s/%s/%ux%u/apps/%s%s", path, *theme, *i, *i, name, *ext);
-                       if (ecore_file_exists(buf))
-                         {
-                            e_icon_file_set(image, buf);
-                            return;
-                         }
+                         return eina_stringshare_add(buf);
                     }
                }
           }
-        for (ext = exts; *ext; ext++)
+     }
+   for (ext = exts; *ext; ext++)
+     {
+        snprintf(buf, sizeof(buf), "%s/%s%s", path, name, *ext);
+        if (ecore_file_exists(buf))
+          return eina_stringshare_add(buf);
+     }
+   return NULL;
+}
+
+/* icons change often while IconThemePath contents rarely do, so remember
+ * what each name resolved to, including names which resolved to nothing
+ */
+static const char *
+_icon_file_get(const char *path, const char *name)
+{
+   Notifier_Icon_Dir *id;
+   const char *file;
+
+   if (!ctx->icon_dirs)
+     ctx->icon_dirs = eina_hash_string_superfast_new((Eina_Free_Cb)_icon_dir_free);
+   id = eina_hash_find(ctx->icon_dirs, path);
+   if (!id)
+     {
+        id = E_NEW(Notifier_Icon_Dir, 1);
+        if (!id) return NULL;
+        id->files = eina_hash_string_superfast_new((Eina_Free_Cb)eina_stringshare_del);
+        id->monitors = eina_hash_string_superfast_new((Eina_Free_Cb)ecore_file_monitor_del);
+        eina_hash_add(ctx->icon_dirs, path, id);
+     }
+   if (e_util_strcmp(id->theme, e_config->icon_theme))
+     {
+        eina_stringshare_replace(&id->theme, e_config->icon_theme);
+        eina_hash_free_buckets(id->files);
+     }
+   file = eina_hash_find(id->files, name);
+   if (!file)
+     {
+        file = _icon_dir_file_find(id, path, name);
+        if (!file) file = eina_stringshare_add("");
+        eina_hash_add(id->files, name, file);
+     }
+   return file[0] ? file : NULL;
+}
+
+/* the icon is only touched when what it should show has changed */
+static void
+image_load(Notifier_Item_Icon *ii, const char *name, const char *path, uint32_t *imgdata, int w, int h)
+{
+   Evas_Object *image = ii->icon;
+
+   if (path && path[0] && name)
+     {
+        const char *file;
+
+        file = _icon_file_get(path, name);
+        if (file)
           {
-             snprintf(buf, sizeof(buf), "%s/%s%s", path, name, *ext);
-             if (ecore_file_exists(buf))
-               {
-                  e_icon_file_set(image, buf);
-                  return;
-               }
+             if (ii->file == file) return;
+             eina_stringshare_replace(&ii->file, file);
+             eina_stringshare_replace(&ii->theme_name, NULL);
+             ii->imgdata = NULL;
+             e_icon_file_set(image, file);
+             return;
           }
      }
-   if (name && name[0] && e_util_icon_theme_set(image, name)) return;
+   eina_stringshare_replace(&ii->file, NULL);
+   if (name && name[0])
+     {
+        if (ii->theme_name && (!strcmp(ii->theme_name, name))) return;
+        if (e_util_icon_theme_set(image, name))
+          {
+             eina_stringshare_replace(&ii->theme_name, name);
+             ii->imgdata = NULL;
+             return;
+          }
+     }
+   eina_stringshare_replace(&ii->theme_name, NULL);
    if (imgdata)
      {
         Evas_Object *o;
 
+        if ((ii->imgdata == imgdata) && (ii->imgserial == ii->item->imgserial))
+          return;
         o = evas_object_image_filled_add(evas_object_evas_get(image));
         evas_object_image_alpha_set(o, 1);
         evas_object_image_size_set(o, w, h);
         evas_object_image_data_set(o, imgdata);
         e_icon_image_object_set(image, o);
+        ii->imgdata = imgdata;
+        ii->imgserial = ii->item->imgserial;
      }
    else
-     e_util_icon_theme_set(image, "dialog-error");
+     {
+        ii->imgdata = NULL;
+        e_util_icon_theme_set(image, "dialog-error");
+     }
 }
 
 static void
@@ -327,7 +471,7 @@ jump_search:
      {
       case STATUS_ACTIVE:
         {
-           image_load(item->icon_name, item->icon_path, item->imgdata, item->imgw, item->imgh, ii->icon);
+           image_load(ii, item->icon_name, item->icon_path, item->imgdata, item->imgw, item->imgh);
            if (!evas_object_visible_get(ii->icon))
              {
                 systray_edje_box_append(host_inst->inst, ii->icon);
@@ -346,7 +490,7 @@ jump_search:
         }
       case STATUS_ATTENTION:
         {
-           image_load(item->attention_icon_name, item->icon_path, item->attnimgdata, item->attnimgw, item->attnimgh, ii->icon);
+           image_load(ii, item->attention_icon_name, item->icon_path, item->attnimgdata, item->attnimgw, item->attnimgh);
            if (!evas_object_visible_get(ii->icon))
              {
                 systray_edje_box_append(host_inst->inst, ii->icon);
@@ -397,18 +541,42 @@ systray_notifier_host_free(Instance_Notifier_Host *notifier)
         Notifier_Item_Icon *ii = EINA_INLIST_CONTAINER_GET(notifier->ii_list, Notifier_Item_Icon);
         notifier->ii_list = eina_inlist_remove(notifier->ii_list,
                                                notifier->ii_list);
+        eina_stringshare_del(ii->file);
+        eina_stringshare_del(ii->theme_name);
         free(ii);
      }
    ctx->instances = eina_inlist_remove(ctx->instances, EINA_INLIST_GET(notifier));
    free(notifier);
 }
 
+static Eina_Bool
+_icon_theme_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_UNUSED)
+{
+   Instance_Notifier_Host *host_inst;
+   Notifier_Item_Icon *ii;
+   Notifier_Item *item;
+
+   /* the same theme icon name may stand for another image now */
+   EINA_INLIST_FOREACH(ctx->instances, host_inst)
+     {
+        EINA_INLIST_FOREACH(host_inst->ii_list, ii)
+          eina_stringshare_replace(&ii->theme_name, NULL);
+     }
+   EINA_INLIST_FOREACH(ctx->item_list, item)
+     systray_notifier_item_update(item);
+   return ECORE_CALLBACK_PASS_ON;
+}
+
 void
 systray_notifier_host_init(void)
 {
    ctx = calloc(1, sizeof(Context_Notifier_Host));
    EINA_SAFETY_ON_NULL_RETURN(ctx);
    systray_notifier_dbus_init(ctx);
+   E_LIST_HANDLER_APPEND(ctx->handlers, E_EVENT_CONFIG_ICON_THEME,
+                         _icon_theme_cb, NULL);
+   E_LIST_HANDLER_APPEND(ctx->handlers, EFREET_EVENT_ICON_CACHE_UPDATE,
+                         _icon_theme_cb, NULL);
 }
 
 void
@@ -416,8 +584,10 @@ systray_notifier_host_shutdown(void)
 {
    Eldbus_Pending *p;
 
+   E_FREE_LIST(ctx->handlers, ecore_event_handler_del);
    EINA_LIST_FREE(ctx->pending, p) eldbus_pending_cancel(p);
    systray_notifier_dbus_shutdown(ctx);
+   E_FREE_FUNC(ctx->icon_dirs, eina_hash_free);
    free(ctx);
    ctx = NULL;
 }
@@ -56,10 +56,16 @@ id_find(const char *s, const char *names[])
    return 0;
 }
 
-static void
+/* replaces *data with the largest image in variant, unless it has exactly
+ * the same pixels: the old buffer is kept then so the icon need not reload;
+ * returns whether *data changed
+ */
+static Eina_Bool
 icon_pixmap_deserialize(Eldbus_Message_Iter *variant, uint32_t **data, int *w, int *h)
 {
    Eldbus_Message_Iter *iter, *struc;
+   uint32_t *olddata = *data;
+   int oldw = *w, oldh = *h;
    int tmpw, tmph;
 
    *data = NULL;
@@ -121,6 +127,15 @@ icon_pixmap_deserialize(Eldbus_Message_Iter *variant, uint32_t **data, int *w, i
                }
           }
      }
+   if (olddata && *data && (oldw == *w) && (oldh == *h) &&
+       (!memcmp(olddata, *data, (size_t)*w * *h * 4)))
+     {
+        free(*data);
+        *data = olddata;
+        return EINA_FALSE;
+     }
+   free(olddata);
+   return (olddata || *data);
 }
 
 static void
@@ -144,15 +159,15 @@ item_prop_get(void *data, const void *key, Eldbus_Message_Iter *var)
      }
    else if (!strcmp(key, "IconPixmap"))
      {
-        free(item->imgdata);
         printf("SYSTRAY: %s ...\n", (const char *)key);
-        icon_pixmap_deserialize(var, &item->imgdata, &item->imgw, &item->imgh);
+        if (icon_pixmap_deserialize(var, &item->imgdata, &item->imgw, &item->imgh))
+          item->imgserial++;
      }
    else if (!strcmp(key, "AttentionIconPixmap"))
      {
-        free(item->attnimgdata);
         printf("SYSTRAY: %s ...\n", (const char *)key);
-        icon_pixmap_deserialize(var, &item->attnimgdata, &item->attnimgw, &item->attnimgh);
+        if (icon_pixmap_deserialize(var, &item->attnimgdata, &item->attnimgw, &item->attnimgh))
+          item->imgserial++;
      }
    else if (!strcmp(key, "AttentionIconName"))
      {
@@ -284,9 +299,9 @@ attention_icon_pixmap_get_cb(void *data, const Eldbus_Message *msg, Eldbus_Pendi
    Eldbus_Message_Iter *variant;
 
    if (!eldbus_message_arguments_get(msg, "v", &variant)) return;
-   free(item->attnimgdata);
    printf("SYSTRAY: %s ...\n", "AttentionIconPixmap");
-   icon_pixmap_deserialize(variant, &item->attnimgdata, &item->attnimgw, &item->attnimgh);
+   if (icon_pixmap_deserialize(variant, &item->attnimgdata, &item->attnimgw, &item->attnimgh))
+     item->imgserial++;
    systray_notifier_item_update(item);
 }
 
@@ -316,9 +331,9 @@ icon_pixmap_get_cb(void *data, const Eldbus_Message *msg, Eldbus_Pending *pendin
    Eldbus_Message_Iter *variant;
 
    if (!eldbus_message_arguments_get(msg, "v", &variant)) return;
-   free(item->imgdata);
    printf("SYSTRAY: %s ...\n", "IconPixmap");
-   icon_pixmap_deserialize(variant, &item->imgdata, &item->imgw, &item->imgh);
+   if (icon_pixmap_deserialize(variant, &item->imgdata, &item->imgw, &item->imgh))
+     item->imgserial++;
    systray_notifier_item_update(item);
 }
 
@@ -19,6 +19,10 @@ typedef struct _Notifier_Data
    EINA_INLIST;
    Notifier_Item *item;
    Evas_Object *icon;
+   Eina_Stringshare *file; // file currently shown in icon
+   Eina_Stringshare *theme_name; // theme icon currently shown in icon
+   uint32_t *imgdata; // pixmap currently shown in icon
+   unsigned int imgserial; // item->imgserial when imgdata was shown
 } Notifier_Item_Icon;
 
 struct _Instance_Notifier_Host
@@ -38,6 +42,8 @@ struct _Context_Notifier_Host
    Eina_Inlist *item_list;
    Eina_Inlist *instances;
    Eina_List *pending;
+   Eina_Hash *icon_dirs; // IconThemePath -> Notifier_Icon_Dir
+   Eina_List *handlers;
 };
 
 struct _Notifier_Item
@@ -61,6 +67,7 @@ struct _Notifier_Item
    int imgw, imgh;
    uint32_t *attnimgdata;
    int attnimgw, attnimgh;
+   unsigned int imgserial; // bumped whenever imgdata or attnimgdata change
 };
 
 typedef void (*E_Notifier_Watcher_Item_Registered_Cb)(void *data, const char *service, const char *path);
@@ -35,6 +35,7 @@ struct _Tasks
    E_Comp_Object_Mover *iconify_provider;
    Evas_Object     *o_items; // Table of items
    Eina_List       *items; // List of items
+   Eina_Hash       *item_hash; // Stack bottom client -> item
    Eina_List       *clients; // List of clients
    E_Zone          *zone; // Current Zone
    Config_Item     *config; // Configuration
@@ -51,18 +52,20 @@ struct _Tasks_Item
    Eina_Bool focused E_BITFIELD;
    Eina_Bool urgent E_BITFIELD;
    Eina_Bool iconified E_BITFIELD;
+   Eina_Bool keep E_BITFIELD;
 };
 
 static Tasks       *_tasks_new(Evas *e, E_Zone *zone, const char *id);
 static void         _tasks_free(Tasks *tasks);
 static void         _tasks_refill(Tasks *tasks);
+static void         _tasks_rebuild(Tasks *tasks);
 static void         _tasks_refill_all();
 static void         _tasks_refill_border(E_Client *ec);
 
 static Tasks_Item  *_tasks_item_find(Tasks *tasks, E_Client *ec);
 static Tasks_Item  *_tasks_item_new(Tasks *tasks, E_Client *ec);
 
-static int          _tasks_item_check_add(Tasks *tasks, E_Client *ec);
+static Eina_Bool    _tasks_item_wanted(Tasks *tasks, E_Client *ec);
 static void         _tasks_item_add(Tasks *tasks, E_Client *ec);
 static void         _tasks_item_remove(Tasks_Item *item);
 static void         _tasks_item_refill(Tasks_Item *item);
@@ -261,7 +264,7 @@ _gc_orient(E_Gadcon_Client *gcc, E_Gadcon_Orient orient)
           {
              tasks->horizontal = 1;
              elm_box_horizontal_set(tasks->o_items, tasks->horizontal);
-             _tasks_refill(tasks);
+             _tasks_rebuild(tasks);
           }
         break;
 
@@ -276,7 +279,7 @@ _gc_orient(E_Gadcon_Client *gcc, E_Gadcon_Orient orient)
           {
              tasks->horizontal = 0;
              elm_box_horizontal_set(tasks->o_items, tasks->horizontal);
-             _tasks_refill(tasks);
+             _tasks_rebuild(tasks);
           }
         break;
 
@@ -370,6 +373,7 @@ _tasks_new(Evas *e, E_Zone *zone, const char *id)
    tasks = E_NEW(Tasks, 1);
    tasks->config = _tasks_config_item_get(id);
    tasks->o_items = elm_box_add(e_win_evas_win_get(e));
+   tasks->item_hash = eina_hash_pointer_new(NULL);
    tasks->horizontal = 1;
    EINA_LIST_FOREACH(e_comp->clients, l, ec)
      {
@@ -393,27 +397,62 @@ _tasks_free(Tasks *tasks)
    e_comp_object_effect_mover_del(tasks->iconify_provider);
    EINA_LIST_FREE(tasks->items, item)
      _tasks_item_free(item);
+   eina_hash_free(tasks->item_hash);
    eina_list_free(tasks->clients);
    evas_object_del(tasks->o_items);
    free(tasks);
 }
 
+/* Brings the items in line with the clients the tasks should show. Items
+ * of clients still shown are kept as they are, so a desk switch only
+ * creates edje objects for the clients that appear and drops the ones
+ * that go. */
 static void
 _tasks_refill(Tasks *tasks)
 {
-   Eina_List *l;
+   Eina_List *l, *ll, *items = NULL;
    E_Client *ec;
    Tasks_Item *item;
    Evas_Coord w, h, tw, th;
+   Eina_Bool reorder = EINA_FALSE;
 
-   while (tasks->items)
+   EINA_LIST_FOREACH(tasks->clients, l, ec)
      {
-        item = tasks->items->data;
+        if (!_tasks_item_wanted(tasks, ec)) continue;
+        item = eina_hash_find(tasks->item_hash, &ec);
+        if (item)
+          {
+             if (item->keep) continue;
+             item->keep = EINA_TRUE;
+             items = eina_list_append(items, item);
+             continue;
+          }
+        _tasks_item_add(tasks, ec);
+        item = eina_list_last_data_get(tasks->items);
+        item->keep = EINA_TRUE;
+        items = eina_list_append(items, item);
+     }
+   EINA_LIST_FOREACH_SAFE(tasks->items, l, ll, item)
+     {
+        if (item->keep) continue;
         _tasks_item_remove(item);
      }
-   EINA_LIST_FOREACH(tasks->clients, l, ec)
+   /* tasks->items now holds the same items as items, maybe in another
+    * order - only then are they repacked */
+   for (l = tasks->items, ll = items; l && ll; l = l->next, ll = ll->next)
      {
-        _tasks_item_check_add(tasks, ec);
+        ((Tasks_Item *)ll->data)->keep = EINA_FALSE;
+        if (l->data != ll->data) reorder = EINA_TRUE;
+     }
+   for (; ll; ll = ll->next)
+     ((Tasks_Item *)ll->data)->keep = EINA_FALSE;
+   eina_list_free(tasks->items);
+   tasks->items = items;
+   if (reorder)
+     {
+        elm_box_unpack_all(tasks->o_items);
+        EINA_LIST_FOREACH(tasks->items, l, item)
+          elm_box_pack_end(tasks->o_items, item->o_item);
      }
    if (tasks->items)
      {
@@ -448,6 +487,17 @@ _tasks_refill(Tasks *tasks)
      e_gadcon_client_min_size_set(tasks->gcc, 0, 0);
 }
 
+/* Drops every item before refilling. The item group and the icon/label
+ * state are only set up when an item is created, so kept items would go
+ * stale after an orientation or display mode change. */
+static void
+_tasks_rebuild(Tasks *tasks)
+{
+   while (tasks->items)
+     _tasks_item_remove(tasks->items->data);
+   _tasks_refill(tasks);
+}
+
 static Eina_Bool
 _refill_timer(void *d EINA_UNUSED)
 {
@@ -484,49 +534,28 @@ _tasks_refill_border(E_Client *ec)
 {
    const Eina_List *l;
    Tasks *tasks;
-   Eina_Bool found = EINA_FALSE;
+   Tasks_Item *item;
 
    EINA_LIST_FOREACH(tasks_config->tasks, l, tasks)
      {
-        const Eina_List *m;
-        Tasks_Item *item;
-        EINA_LIST_FOREACH(tasks->items, m, item)
+        item = _tasks_item_find(tasks, ec);
+        if (item)
           {
-             E_Client *ec2;
-
-             ec2 = e_client_stack_bottom_get(item->client);
-             for (; ec2; ec2 = ec2->stack.next)
-               {
-                  if (ec2 == ec)
-                    {
-                       _tasks_item_refill(item);
-                       found = EINA_TRUE;
-                       goto done;
-                    }
-               }
+             _tasks_item_refill(item);
+             return;
           }
      }
-done:
-   if (!found) _tasks_refill_all();
+   _tasks_refill_all();
 }
 
+/* items are only made for clients at the bottom of their stack, so that
+ * is all there is to look up */
 static Tasks_Item *
 _tasks_item_find(Tasks *tasks, E_Client *ec)
 {
-   const Eina_List *l;
-   Tasks_Item *item;
-
-   EINA_LIST_FOREACH(tasks->items, l, item)
-     {
-        E_Client *ec2;
-
-        ec2 = e_client_stack_bottom_get(item->client);
-        for (; ec2; ec2 = ec2->stack.next)
-          {
-             if (ec2 == ec) return item;
-          }
-     }
-   return NULL;
+   if (!ec) return NULL;
+   ec = e_client_stack_bottom_get(ec);
+   return eina_hash_find(tasks->item_hash, &ec);
 }
 
 static Tasks_Item *
@@ -575,23 +604,21 @@ _tasks_item_new(Tasks *tasks, E_Client *ec)
    return item;
 }
 
-static int
-_tasks_item_check_add(Tasks *tasks, E_Client *ec)
+static Eina_Bool
+_tasks_item_wanted(Tasks *tasks, E_Client *ec)
 {
-   if (ec->user_skip_winlist) return 1;
-   if (ec->netwm.state.skip_taskbar) return 1;
-   if (ec->stack.prev) return 1;
-   if (_tasks_item_find(tasks, ec)) return 1;
-   if (!tasks->config) return 1;
+   if (ec->user_skip_winlist) return EINA_FALSE;
+   if (ec->netwm.state.skip_taskbar) return EINA_FALSE;
+   if (ec->stack.prev) return EINA_FALSE;
+   if (!tasks->config) return EINA_FALSE;
    if (!(tasks->config->show_all))
      {
-        if (ec->zone != tasks->zone) return 1;
+        if (ec->zone != tasks->zone) return EINA_FALSE;
         if ((ec->desk != e_desk_current_get(ec->zone)) &&
             (!ec->sticky))
-          return 1;
+          return EINA_FALSE;
      }
-   _tasks_item_add(tasks, ec);
-   return 0;
+   return EINA_TRUE;
 }
 
 static void
@@ -604,12 +631,14 @@ _tasks_item_add(Tasks *tasks, E_Client *ec)
    E_FILL(item->o_item);
    elm_box_pack_end(tasks->o_items, item->o_item);
    tasks->items = eina_list_append(tasks->items, item);
+   eina_hash_add(tasks->item_hash, &ec, item);
 }
 
 static void
 _tasks_item_remove(Tasks_Item *item)
 {
    item->tasks->items = eina_list_remove(item->tasks->items, item);
+   eina_hash_del_by_key(item->tasks->item_hash, &item->client);
    elm_box_unpack(item->tasks->o_items, item->o_item);
    _tasks_item_free(item);
 }
@@ -771,7 +800,7 @@ _tasks_config_updated(Config_Item *config)
    if (!tasks_config) return;
    EINA_LIST_FOREACH(tasks_config->tasks, l, tasks)
      {
-        if (tasks->config == config) _tasks_refill(tasks);
+        if (tasks->config == config) _tasks_rebuild(tasks);
      }
 }
 